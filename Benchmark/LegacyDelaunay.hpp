@@ -0,0 +1,148 @@
+/*************************************************
+ * Copyright (c) 2017 Toru Ito
+ * Released under the MIT license
+ * http://opensource.org/licenses/mit-license.php
+ *************************************************/
+
+#ifndef LegacyDelaunay_hpp
+#define LegacyDelaunay_hpp
+
+#include <vector>
+#include <algorithm>
+#include <Eigen/Core>
+#include <Eigen/Geometry>
+
+// The original full-scan Bowyer-Watson, kept only as a baseline for the benchmark.
+class LegacyDelaunay
+{
+public:
+    struct TriangleData
+    {
+        unsigned long   index1, index2, index3;
+        double          radius;
+        Eigen::Vector2d center;
+        
+        bool IsInside( const Eigen::Vector2d& point ) const
+        {
+            return ( point - center ).norm() <= radius;
+        }
+    };
+    
+    struct EdgeData
+    {
+        unsigned long index1, index2;
+        
+        EdgeData( unsigned long index1, unsigned long index2 )
+        {
+            this->index1 = std::min( index1, index2 );
+            this->index2 = std::max( index1, index2 );
+        }
+        
+        bool operator<( const EdgeData& other ) const
+        {
+            return index1 < other.index1 || ( index1 == other.index1 && index2 < other.index2 );
+        }
+        
+        bool operator==( const EdgeData& other ) const
+        {
+            return index1 == other.index1 && index2 == other.index2;
+        }
+    };
+    
+    unsigned long Triangulation( const std::vector< Eigen::Vector2d >& points )
+    {
+        m_Points = points;
+        m_Triangles.clear();
+        
+        unsigned long PointSize = m_Points.size();
+        Eigen::Vector2d min = m_Points.front(), max = m_Points.front();
+        
+        for( auto point : m_Points ) {
+            min = min.cwiseMin( point );
+            max = max.cwiseMax( point );
+        }
+        
+        Eigen::Vector2d delta = ( max - min ) * 0.5;
+        min -= delta;
+        max += delta;
+        
+        m_Points.push_back( Eigen::Vector2d( min.x(), min.y() ) );
+        m_Points.push_back( Eigen::Vector2d( max.x(), min.y() ) );
+        m_Points.push_back( Eigen::Vector2d( max.x(), max.y() ) );
+        m_Points.push_back( Eigen::Vector2d( min.x(), max.y() ) );
+        
+        AddTriangle( PointSize, PointSize + 1, PointSize + 2 );
+        AddTriangle( PointSize, PointSize + 2, PointSize + 3 );
+        
+        for( unsigned long index = 0; index < PointSize; ++index ) {
+            std::vector< TriangleData > triangles;
+            std::vector< EdgeData > edges;
+            
+            for( auto tri : m_Triangles ) {
+                if( tri.IsInside( m_Points[index] ) ) {
+                    edges.push_back( EdgeData( tri.index1, tri.index2 ) );
+                    edges.push_back( EdgeData( tri.index2, tri.index3 ) );
+                    edges.push_back( EdgeData( tri.index3, tri.index1 ) );
+                } else {
+                    triangles.push_back( tri );
+                }
+            }
+            
+            m_Triangles.swap( triangles );
+            std::sort( edges.begin(), edges.end() );
+            
+            for( size_t i = 0; i < edges.size(); ) {
+                if( i + 1 < edges.size() && edges[i] == edges[i + 1] ) {
+                    i += 2;
+                } else {
+                    AddTriangle( edges[i].index1, edges[i].index2, index );
+                    i += 1;
+                }
+            }
+        }
+        
+        unsigned long count = 0;
+        
+        for( auto tri : m_Triangles ) {
+            if( tri.index1 < PointSize && tri.index2 < PointSize && tri.index3 < PointSize )
+                ++count;
+        }
+        
+        return count;
+    }
+    
+private:
+    std::vector< TriangleData >    m_Triangles;
+    std::vector< Eigen::Vector2d > m_Points;
+    
+    void AddTriangle( unsigned long index1, unsigned long index2, unsigned long index3 )
+    {
+        Eigen::Vector2d p1 = m_Points[index1];
+        Eigen::Vector2d p2 = m_Points[index2];
+        Eigen::Vector2d p3 = m_Points[index3];
+        
+        Eigen::MatrixXd A(2,2);
+        Eigen::VectorXd b(2);
+        
+        A( 0, 0 ) = 2.0 * ( p2.x() - p1.x() );
+        A( 0, 1 ) = 2.0 * ( p2.y() - p1.y() );
+        A( 1, 0 ) = 2.0 * ( p3.x() - p1.x() );
+        A( 1, 1 ) = 2.0 * ( p3.y() - p1.y() );
+        
+        b(0) = - p1.x() * p1.x() + p2.x() * p2.x() - p1.y() * p1.y() + p2.y() * p2.y();
+        b(1) = - p1.x() * p1.x() + p3.x() * p3.x() - p1.y() * p1.y() + p3.y() * p3.y();
+        
+        Eigen::VectorXd x = A.fullPivLu().solve(b);
+        
+        TriangleData triangle;
+        triangle.index1 = index1;
+        triangle.index2 = index2;
+        triangle.index3 = index3;
+        triangle.center = Eigen::Vector2d( x[0], x[1] );
+        triangle.radius = ( triangle.center - p1 ).norm();
+        
+        m_Triangles.push_back( triangle );
+    }
+};
+
+#endif /* LegacyDelaunay_hpp */
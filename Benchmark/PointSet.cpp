@@ -0,0 +1,92 @@
+/*************************************************
+ * Copyright (c) 2017 Toru Ito
+ * Released under the MIT license
+ * http://opensource.org/licenses/mit-license.php
+ *************************************************/
+
+#include "PointSet.hpp"
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+const char *PointSet::GetName( Distribution distribution )
+{
+    const char *name[] = { "uniform", "gaussian_cluster", "grid", "circle", "near_duplicate" };
+    
+    return ( distribution < DISTRIBUTION_COUNT ) ? name[distribution] : "unknown";
+}
+
+void PointSet::Generate( Distribution distribution, unsigned long size, unsigned int seed, std::vector< Eigen::Vector2d > *pPointList )
+{
+    std::mt19937 random( seed );
+    std::uniform_real_distribution< double > uniform( 0.0, 1.0 );
+    std::normal_distribution< double > normal( 0.0, 1.0 );
+    unsigned long k;
+    
+    pPointList->clear();
+    pPointList->reserve( size );
+    
+    switch( distribution ) {
+        case UNIFORM:
+            for( k = 0; k < size; ++k ) {
+                pPointList->push_back( Eigen::Vector2d( uniform( random ), uniform( random ) ) );
+            }
+            break;
+            
+        // 16 clusters with a spread of 1% of the unit square
+        case GAUSSIAN_CLUSTER: {
+            std::vector< Eigen::Vector2d > center;
+            
+            for( k = 0; k < 16; ++k ) {
+                center.push_back( Eigen::Vector2d( uniform( random ), uniform( random ) ) );
+            }
+            
+            for( k = 0; k < size; ++k ) {
+                const Eigen::Vector2d& c = center[k % center.size()];
+                pPointList->push_back( Eigen::Vector2d( c.x() + 0.01 * normal( random ), c.y() + 0.01 * normal( random ) ) );
+            }
+            break;
+        }
+            
+        // Every cell is cocircular, the order is shuffled so the input is not presorted
+        case GRID: {
+            unsigned long side = static_cast< unsigned long >( std::ceil( std::sqrt( static_cast< double >( size ) ) ) );
+            
+            for( k = 0; k < size; ++k ) {
+                pPointList->push_back( Eigen::Vector2d( static_cast< double >( k % side ), static_cast< double >( k / side ) ) );
+            }
+            
+            std::shuffle( pPointList->begin(), pPointList->end(), random );
+            break;
+        }
+            
+        case CIRCLE:
+            for( k = 0; k < size; ++k ) {
+                double angle = 2.0 * M_PI * uniform( random );
+                pPointList->push_back( Eigen::Vector2d( std::cos( angle ), std::sin( angle ) ) );
+            }
+            break;
+            
+        // Half of the points repeat another one exactly or within a few units in the last place
+        case NEAR_DUPLICATE:
+            for( k = 0; k < size; ++k ) {
+                if( k % 2 == 0 || pPointList->empty() ) {
+                    pPointList->push_back( Eigen::Vector2d( uniform( random ), uniform( random ) ) );
+                    continue;
+                }
+                
+                Eigen::Vector2d point = (*pPointList)[random() % pPointList->size()];
+                
+                if( k % 4 == 3 ) {
+                    point.x() += 1e-15 * ( uniform( random ) - 0.5 );
+                    point.y() += 1e-15 * ( uniform( random ) - 0.5 );
+                }
+                
+                pPointList->push_back( point );
+            }
+            break;
+            
+        default:
+            break;
+    }
+}
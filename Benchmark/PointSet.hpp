@@ -0,0 +1,32 @@
+/*************************************************
+ * Copyright (c) 2017 Toru Ito
+ * Released under the MIT license
+ * http://opensource.org/licenses/mit-license.php
+ *************************************************/
+
+#ifndef PointSet_hpp
+#define PointSet_hpp
+
+#include <vector>
+#include <Eigen/Core>
+
+// Point distributions for the benchmark, from the easy uniform case to inputs that stress
+// the predicates ( cocircular, near-duplicate ) or the point location ( clusters ).
+class PointSet
+{
+public:
+    enum Distribution
+    {
+        UNIFORM,
+        GAUSSIAN_CLUSTER,
+        GRID,
+        CIRCLE,
+        NEAR_DUPLICATE,
+        DISTRIBUTION_COUNT
+    };
+    
+    static const char *GetName( Distribution distribution );
+    static void Generate( Distribution distribution, unsigned long size, unsigned int seed, std::vector< Eigen::Vector2d > *pPointList );
+};
+
+#endif /* PointSet_hpp */
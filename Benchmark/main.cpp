@@ -0,0 +1,297 @@
+/*************************************************
+ * Copyright (c) 2017 Toru Ito
+ * Released under the MIT license
+ * http://opensource.org/licenses/mit-license.php
+ *************************************************/
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <new>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include <sys/resource.h>
+
+#include <Eigen/Core>
+#include <Eigen/Geometry>
+
+#include "../Delaunay/Delaunay.hpp"
+#include "../Delaunay/Predicates.hpp"
+#include "LegacyDelaunay.hpp"
+#include "PointSet.hpp"
+
+static std::atomic< unsigned long > AllocationCount( 0 );
+
+void* operator new( std::size_t size )
+{
+    ++AllocationCount;
+    
+    void *p = std::malloc( size ? size : 1 );
+    
+    if( p == NULL )
+        throw std::bad_alloc();
+    
+    return p;
+}
+
+void operator delete( void *p ) noexcept
+{
+    std::free( p );
+}
+
+static double Seconds( std::chrono::steady_clock::time_point start )
+{
+    return std::chrono::duration< double >( std::chrono::steady_clock::now() - start ).count();
+}
+
+// Peak resident set size in bytes. On Linux this is the high-water mark that ResetPeakMemory
+// lowers again before each run, elsewhere it is the peak of the whole process so far.
+static unsigned long PeakMemory()
+{
+#ifdef __linux__
+    FILE *pFile = fopen( "/proc/self/status", "r" );
+    char line[256];
+    unsigned long peak = 0;
+    
+    if( pFile != NULL ) {
+        while( fgets( line, sizeof( line ), pFile ) != NULL ) {
+            if( sscanf( line, "VmHWM: %lu kB", &peak ) == 1 )
+                break;
+        }
+        
+        fclose( pFile );
+    }
+    
+    if( peak > 0 )
+        return peak * 1024;
+#endif
+    
+    struct rusage usage;
+    getrusage( RUSAGE_SELF, &usage );
+    
+#ifdef __APPLE__
+    return usage.ru_maxrss;
+#else
+    return usage.ru_maxrss * 1024ul;
+#endif
+}
+
+static void ResetPeakMemory()
+{
+#ifdef __linux__
+    FILE *pFile = fopen( "/proc/self/clear_refs", "w" );
+    
+    if( pFile != NULL ) {
+        fputs( "5", pFile );
+        fclose( pFile );
+    }
+#endif
+}
+
+// Every distribution at 10^3 up to max_size points with both engines, one JSON object per run
+static void RunSuite( unsigned long max_size )
+{
+    const char *SimdName[] = { "none", "sse2", "avx2", "avx512" };
+    const char *EngineName[] = { "bowyer_watson", "divide_and_conquer" };
+    unsigned int threads = std::max( std::thread::hardware_concurrency(), 1u );
+    bool first = true;
+    
+    printf( "{\n  \"simd\": \"%s\",\n  \"threads\": %u,\n  \"runs\": [", SimdName[Predicates::GetSimdLevel()], threads );
+    
+    for( int distribution = 0; distribution < PointSet::DISTRIBUTION_COUNT; ++distribution ) {
+        for( unsigned long size = 1000; size <= max_size; size *= 10 ) {
+            std::vector< Eigen::Vector2d > PointList;
+            PointSet::Generate( static_cast< PointSet::Distribution >( distribution ), size, 2, &PointList );
+            
+            for( int engine = 0; engine < 2; ++engine ) {
+                ResetPeakMemory();
+                
+                auto start = std::chrono::steady_clock::now();
+                unsigned long allocations = AllocationCount;
+                
+                Delaunay<> delaunay( engine == 0 ? Delaunay<>::BOWYER_WATSON : Delaunay<>::DIVIDE_AND_CONQUER );
+                delaunay.SetThreadCount( threads );
+                delaunay.SetPoint( &PointList, engine == 0 ? Delaunay<>::BRIO_ORDER : Delaunay<>::INPUT_ORDER );
+                
+                double set_point_time = Seconds( start );
+                start = std::chrono::steady_clock::now();
+                
+                delaunay.Triangulation();
+                
+                double triangulation_time = Seconds( start );
+                start = std::chrono::steady_clock::now();
+                
+                std::vector< unsigned int > IndexBuffer( 3 * delaunay.GetTriangleCount() );
+                delaunay.GetResult( IndexBuffer.data() );
+                
+                double result_time = Seconds( start );
+                allocations = AllocationCount - allocations;
+                
+                printf( "%s\n    { \"distribution\": \"%s\", \"engine\": \"%s\", \"points\": %lu, \"triangles\": %lu, "
+                        "\"set_point_s\": %.6f, \"triangulation_s\": %.6f, \"result_s\": %.6f, \"points_per_s\": %.0f, "
+                        "\"allocations\": %lu, \"peak_rss_bytes\": %lu",
+                        first ? "" : ",", PointSet::GetName( static_cast< PointSet::Distribution >( distribution ) ), EngineName[engine],
+                        size, IndexBuffer.size() / 3, set_point_time, triangulation_time, result_time,
+                        size / ( set_point_time + triangulation_time ), allocations, PeakMemory() );
+#ifdef DELAUNAY_STATS
+                const Statistics& statistics = delaunay.GetStatistics();
+                
+                printf( ", \"in_circle_tests\": %lu, \"triangles_created\": %lu, \"triangles_destroyed\": %lu",
+                        statistics.inCircleCount, statistics.triangleCreated, statistics.triangleDestroyed );
+#endif
+                printf( " }" );
+                fflush( stdout );
+                first = false;
+            }
+        }
+    }
+    
+    printf( "\n  ]\n}\n" );
+}
+
+// Allocations inside Triangulation for uniform points in every insertion order. Only the
+// scratch buffers may grow, so 10^5 points must not need more than twice as many as 10^3.
+static bool CheckAllocation()
+{
+    const char *OrderName[] = { "input", "hilbert", "brio" };
+    std::mt19937 random( 2 );
+    std::uniform_real_distribution< double > uniform( 0.0, 1.0 );
+    bool pass = true;
+    
+    for( int order = 0; order < 3; ++order ) {
+        unsigned long count[2];
+        
+        for( int k = 0; k < 2; ++k ) {
+            std::vector< Eigen::Vector2d > PointList;
+            
+            for( unsigned long i = 0; i < ( k == 0 ? 1000ul : 100000ul ); ++i ) {
+                PointList.push_back( Eigen::Vector2d( uniform( random ), uniform( random ) ) );
+            }
+            
+            Delaunay<> delaunay;
+            delaunay.SetPoint( &PointList, static_cast< Delaunay<>::InsertionOrder >( order ) );
+            
+            count[k] = AllocationCount;
+            delaunay.Triangulation();
+            count[k] = AllocationCount - count[k];
+        }
+        
+        bool ok = count[1] <= 2 * count[0];
+        printf( "%-8s %8lu allocations for 10^3 points, %8lu for 10^5 %s\n", OrderName[order], count[0], count[1], ok ? "ok" : "FAILED" );
+        pass = pass && ok;
+    }
+    
+    return pass;
+}
+
+int main(int argc, const char * argv[]) {
+    
+    if( argc > 1 && strcmp( argv[1], "--json" ) == 0 ) {
+        RunSuite( ( argc > 2 ) ? std::strtoul( argv[2], NULL, 10 ) : 1000000 );
+        return 0;
+    }
+    
+    if( argc > 1 && strcmp( argv[1], "--check" ) == 0 ) {
+        return CheckAllocation() ? 0 : 1;
+    }
+    
+    unsigned long max_size = ( argc > 1 ) ? std::strtoul( argv[1], NULL, 10 ) : 1000000;
+    unsigned long max_legacy_size = ( argc > 2 ) ? std::strtoul( argv[2], NULL, 10 ) : 20000;
+    
+    std::mt19937 random( 2 );
+    std::uniform_real_distribution< double > uniform( 0.0, 1.0 );
+    
+    const char *SimdName[] = { "none", "sse2", "avx2", "avx512" };
+    printf( "simd: %s\n\n", SimdName[Predicates::GetSimdLevel()] );
+    
+    printf( "%10s %12s %12s %12s %12s %12s %12s\n", "points", "triangles", "walk [s]", "brio [s]", "allocs", "dc [s]", "legacy [s]" );
+    
+    for( unsigned long size = 1000; size <= max_size; size *= 2 ) {
+        
+        std::vector< Eigen::Vector2d > PointList;
+        std::vector< std::vector< unsigned int > > IndexList;
+        
+        for( unsigned long k = 0; k < size; ++k ) {
+            PointList.push_back( Eigen::Vector2d( uniform( random ), uniform( random ) ) );
+        }
+        
+        auto start = std::chrono::steady_clock::now();
+        
+        Delaunay<> delaunay;
+        delaunay.SetPoint( &PointList );
+        delaunay.Triangulation();
+        
+        double time = Seconds( start );
+        
+        start = std::chrono::steady_clock::now();
+        
+        Delaunay<> sorted;
+        sorted.SetPoint( &PointList, Delaunay<>::BRIO_ORDER );
+        
+        unsigned long allocations = AllocationCount;
+        sorted.Triangulation();
+        allocations = AllocationCount - allocations;
+        
+        double sorted_time = Seconds( start );
+        
+        start = std::chrono::steady_clock::now();
+        
+        Delaunay<> divide( Delaunay<>::DIVIDE_AND_CONQUER );
+        divide.SetPoint( &PointList );
+        divide.Triangulation();
+        
+        double divide_time = Seconds( start );
+        
+        std::vector< Eigen::Vector2d > ResultPointList;
+        delaunay.GetResult( &ResultPointList, &IndexList );
+        
+        if( size <= max_legacy_size ) {
+            start = std::chrono::steady_clock::now();
+            
+            LegacyDelaunay legacy;
+            legacy.Triangulation( PointList );
+            
+            printf( "%10lu %12lu %12.4f %12.4f %12lu %12.4f %12.4f\n", size, IndexList.size(), time, sorted_time, allocations, divide_time, Seconds( start ) );
+        } else {
+            printf( "%10lu %12lu %12.4f %12.4f %12lu %12.4f %12s\n", size, IndexList.size(), time, sorted_time, allocations, divide_time, "-" );
+        }
+    }
+    
+    std::vector< Eigen::Vector2d > PointList;
+    
+    for( unsigned long k = 0; k < max_size; ++k ) {
+        PointList.push_back( Eigen::Vector2d( uniform( random ), uniform( random ) ) );
+    }
+    
+    unsigned int max_threads = std::max( std::thread::hardware_concurrency(), 1u );
+    double base_time = 0.0;
+    
+    printf( "\n%10s %12s %12s\n", "threads", "dc [s]", "speedup" );
+    
+    for( unsigned int threads = 1; ; threads *= 2 ) {
+        threads = ( threads < max_threads ) ? threads : max_threads;
+        
+        auto start = std::chrono::steady_clock::now();
+        
+        Delaunay<> divide( Delaunay<>::DIVIDE_AND_CONQUER );
+        divide.SetThreadCount( threads );
+        divide.SetPoint( &PointList );
+        divide.Triangulation();
+        
+        double time = Seconds( start );
+        base_time = ( threads == 1 ) ? time : base_time;
+        
+        printf( "%10u %12.4f %12.2f\n", threads, time, base_time / time );
+        
+        if( threads >= max_threads )
+            break;
+    }
+    
+    return 0;
+}
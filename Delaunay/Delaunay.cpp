@@ -5,23 +5,100 @@
  *************************************************/
 
 #include "Delaunay.hpp"
+#include "DivideAndConquer.hpp"
+#include "Predicates.hpp"
+#include "MeshFile.hpp"
 #include <cmath>
+#include <queue>
+#include <thread>
 
-Delaunay::Delaunay()
+template< typename Scalar, typename Index, typename Predicate >
+const Index Delaunay< Scalar, Index, Predicate >::NO_NEIGHBOR;
+
+template< typename Scalar, typename Index, typename Predicate >
+Delaunay< Scalar, Index, Predicate >::Delaunay( Engine engine )
+    :m_Engine( engine )
+    ,m_ThreadCount( 1 )
+    ,m_MergeDistance( 0 )
+    ,m_SpareCount( NO_NEIGHBOR )
+    ,m_LastTriangle( NO_NEIGHBOR )
+    ,m_Mark( 0 )
+    ,m_Exterior( false )
+    ,m_Stream( false )
+    ,m_StreamCount( 0 )
+{
+}
+
+template< typename Scalar, typename Index, typename Predicate >
+Delaunay< Scalar, Index, Predicate >::~Delaunay()
 {
 }
 
-Delaunay::~Delaunay()
+template< typename Scalar, typename Index, typename Predicate >
+void Delaunay< Scalar, Index, Predicate >::SetPoint( std::vector< Point > *pPointList, InsertionOrder order )
 {
+    SetPoint( pPointList->empty() ? NULL : pPointList->front().data(), pPointList->size(), 2, order );
 }
 
-void Delaunay::SetPoint( std::vector< Eigen::Vector2d > *pPointList )
+template< typename Scalar, typename Index, typename Predicate >
+void Delaunay< Scalar, Index, Predicate >::SetPoint( const Scalar *pCoordinate, Index count, Index stride, InsertionOrder order )
 {
+    SortPoint( pCoordinate, count, stride, order, &m_PointIndex );
+    MergePoint( pCoordinate, count, stride, &m_MergeId );
+    
+    // Merged points come last as copies of the point they merged into. Both engines keep
+    // the first of coincident vertices, so they never reach the mesh.
+    if( !m_MergeId.empty() ) {
+        std::stable_partition( m_PointIndex.begin(), m_PointIndex.end(), [this]( Index id ) {
+            return m_MergeId[id] == id;
+        });
+    }
+    
+    // The working copy is kept in insertion order
     m_Points.clear();
-    std::copy( pPointList->begin(), pPointList->end(), std::back_inserter( m_Points ) );
+    m_Points.reserve( count );
+    
+    for( auto index : m_PointIndex ) {
+        Index source = m_MergeId.empty() ? index : m_MergeId[index];
+        m_Points.push_back( Point( pCoordinate[source * stride], pCoordinate[source * stride + 1] ) );
+    }
+    
+    m_PointVertex.resize( count );
+    
+    for( Index i = 0; i < count; ++i ) {
+        m_PointVertex[m_PointIndex[i]] = i;
+    }
+    
+    m_RemovedVertex.clear();
+    m_SpareCount = NO_NEIGHBOR;
+    m_Constraint.clear();
+    m_Exterior = false;
+    m_Stream = false;
+}
+
+// Only the divide-and-conquer engine runs in parallel, 0 uses every hardware thread
+template< typename Scalar, typename Index, typename Predicate >
+void Delaunay< Scalar, Index, Predicate >::SetThreadCount( unsigned int count )
+{
+    if( count == 0 ) {
+        count = std::thread::hardware_concurrency();
+    }
+    
+    m_ThreadCount = ( count > 0 ) ? count : 1;
+}
+
+template< typename Scalar, typename Index, typename Predicate >
+void Delaunay< Scalar, Index, Predicate >::GetMergedId( std::vector< Index > *pId ) const
+{
+    pId->resize( m_PointVertex.size() );
+    
+    for( Index id = 0; id < m_PointVertex.size(); ++id ) {
+        ( *pId )[id] = ( id < m_MergeId.size() ) ? m_MergeId[id] : id;
+    }
 }
 
-void Delaunay::GetResult( std::vector< Eigen::Vector2d > *pPointList, std::vector< std::vector< unsigned int > > *pIndexList )
+template< typename Scalar, typename Index, typename Predicate >
+void Delaunay< Scalar, Index, Predicate >::GetResult( std::vector< Point > *pPointList, std::vector< std::vector< unsigned int > > *pIndexList )
 {
     pPointList->clear();
     pIndexList->clear();
@@ -29,185 +106,2902 @@ void Delaunay::GetResult( std::vector< Eigen::Vector2d > *pPointList, std::vecto
     std::vector< unsigned int > indexs;
     indexs.resize(3);
 
-    for( auto tri : m_Triangles ) {
-        indexs[0] = static_cast< unsigned int >( tri.index1 );
-        indexs[1] = static_cast< unsigned int >( tri.index2 );
-        indexs[2] = static_cast< unsigned int >( tri.index3 );
+    for( Index i = 0; i < m_Triangles.size(); ++i ) {
+        if( !m_TriangleAlive[i] )
+            continue;
+        
+        const TriangleData& tri = m_Triangles[i];
+        indexs[0] = static_cast< unsigned int >( m_PointIndex[tri.index[0]] );
+        indexs[1] = static_cast< unsigned int >( m_PointIndex[tri.index[1]] );
+        indexs[2] = static_cast< unsigned int >( m_PointIndex[tri.index[2]] );
         pIndexList->push_back( indexs );
     }
 
-    std::copy( m_Points.begin(), m_Points.end(), std::back_inserter( *pPointList ) );
+    pPointList->resize( m_Points.size() );
+    
+    for( Index i = 0; i < m_Points.size(); ++i ) {
+        (*pPointList)[m_PointIndex[i]] = m_Points[i];
+    }
 }
 
-void Delaunay::CreateInitTriangle()
+template< typename Scalar, typename Index, typename Predicate >
+Index Delaunay< Scalar, Index, Predicate >::GetTriangleCount() const
 {
-    m_Triangles.clear();
+    return m_Triangles.size() - m_FreeTriangle.size();
+}
+
+template< typename Scalar, typename Index, typename Predicate >
+void Delaunay< Scalar, Index, Predicate >::GetResult( Index *pIndexBuffer ) const
+{
+    for( Index i = 0; i < m_Triangles.size(); ++i ) {
+        if( !m_TriangleAlive[i] )
+            continue;
+        
+        const TriangleData& tri = m_Triangles[i];
+        *pIndexBuffer++ = m_PointIndex[tri.index[0]];
+        *pIndexBuffer++ = m_PointIndex[tri.index[1]];
+        *pIndexBuffer++ = m_PointIndex[tri.index[2]];
+    }
+}
 
-    unsigned long PointSize = m_Points.size();
-    double x_min, x_max, y_min, y_max, x_delta, y_delta;
+template< typename Scalar, typename Index, typename Predicate >
+bool Delaunay< Scalar, Index, Predicate >::Write( const char *pFileName, bool neighbor ) const
+{
+    // A stream keeps only its front, and the format is little-endian only
+    if( m_Stream || !MeshFile::IsLittleEndian() )
+        return false;
+    
+    Index triangleCount = GetTriangleCount();
+    
+    MeshFile::Header header;
+    MeshFile::InitHeader( &header, sizeof( Scalar ), sizeof( Index ), m_Points.size(), triangleCount, neighbor );
+    
+    std::vector< Scalar > coordinate( 2 * m_Points.size() );
+    
+    for( Index i = 0; i < m_Points.size(); ++i ) {
+        coordinate[2 * m_PointIndex[i]] = m_Points[i].x();
+        coordinate[2 * m_PointIndex[i] + 1] = m_Points[i].y();
+    }
     
-    x_min = m_Points.front().x();
-    x_max = m_Points.front().x();
-    y_min = m_Points.front().y();
-    y_max = m_Points.front().y();
+    std::vector< Index > index( 3 * triangleCount );
     
-    for( auto point : m_Points ) {
-        x_min = ( x_min < point.x() ) ? x_min : point.x();
-        x_max = ( x_max > point.x() ) ? x_max : point.x();
-        y_min = ( y_min < point.y() ) ? y_min : point.y();
-        y_max = ( y_max > point.y() ) ? y_max : point.y();
+    if( triangleCount > 0 ) {
+        GetResult( &index[0] );
     }
     
-    x_delta = x_max - x_min;
-    y_delta = y_max - y_min;
+    std::vector< Index > adjacent;
+    
+    if( neighbor ) {
+        adjacent.resize( 3 * triangleCount );
+        
+        if( triangleCount > 0 ) {
+            GetNeighbor( &adjacent[0] );
+        }
+    }
     
-    x_min -= x_delta * 0.5;
-    x_max += x_delta * 0.5;
-    y_min -= y_delta * 0.5;
-    y_max += y_delta * 0.5;
+    FILE *pFile = fopen( pFileName, "wb" );
     
-    m_Points.push_back( Eigen::Vector2d( x_min, y_min ) );
-    m_Points.push_back( Eigen::Vector2d( x_max, y_min ) );
-    m_Points.push_back( Eigen::Vector2d( x_max, y_max ) );
-    m_Points.push_back( Eigen::Vector2d( x_min, y_max ) );
+    if( pFile == NULL )
+        return false;
     
-    AddTriangle( PointSize, PointSize + 1, PointSize + 2 );
-    AddTriangle( PointSize, PointSize + 2, PointSize + 3 );
+    static const char padding[16] = { 0 };
+    bool success = fwrite( &header, sizeof( header ), 1, pFile ) == 1;
+    uint64_t offset = sizeof( header );
     
-    m_InitTrianglePointIndex.clear();
+    const void *pSection[3] = { coordinate.data(), index.data(), adjacent.data() };
+    uint64_t sectionOffset[3] = { header.pointOffset, header.indexOffset, header.neighborOffset };
+    size_t sectionSize[3] = { coordinate.size() * sizeof( Scalar ), index.size() * sizeof( Index ), adjacent.size() * sizeof( Index ) };
     
-    for( unsigned long i = 0; i < 4; ++i ) {
-        m_InitTrianglePointIndex.push_back( PointSize + i );
+    for( int k = 0; k < 3 && success; ++k ) {
+        if( k == 2 && !neighbor )
+            break;
+        
+        success = fwrite( padding, 1, sectionOffset[k] - offset, pFile ) == sectionOffset[k] - offset;
+        
+        if( success && sectionSize[k] > 0 ) {
+            success = fwrite( pSection[k], 1, sectionSize[k], pFile ) == sectionSize[k];
+        }
+        
+        offset = sectionOffset[k] + sectionSize[k];
     }
+    
+    return ( fclose( pFile ) == 0 ) && success;
 }
 
-void Delaunay::DeleteInitTriangle()
+// Neighbors refer to the triangles in the order GetResult writes them, dead slots are skipped
+template< typename Scalar, typename Index, typename Predicate >
+void Delaunay< Scalar, Index, Predicate >::GetNeighbor( Index *pNeighborBuffer ) const
 {
-    std::set< unsigned long > PointIndex;
+    std::vector< Index > order;
+    
+    GetTriangleOrder( &order );
     
-    for( auto index : m_InitTrianglePointIndex ) {
-        PointIndex.insert( index );
+    for( Index i = 0; i < m_Triangles.size(); ++i ) {
+        if( !m_TriangleAlive[i] )
+            continue;
+        
+        for( int k = 0; k < 3; ++k ) {
+            Index n = m_Triangles[i].neighbor[k];
+            *pNeighborBuffer++ = ( n == NO_NEIGHBOR ) ? NO_NEIGHBOR : order[n];
+        }
     }
+}
+
+template< typename Scalar, typename Index, typename Predicate >
+void Delaunay< Scalar, Index, Predicate >::GetBoundary( std::vector< Index > *pEdge ) const
+{
+    pEdge->clear();
     
-    m_Triangles.erase( std::remove_if( begin(m_Triangles), end(m_Triangles), [PointIndex]( TriangleData &tri ) {
+    for( Index i = 0; i < m_Triangles.size(); ++i ) {
+        if( !m_TriangleAlive[i] )
+            continue;
         
-        if( PointIndex.find( tri.index1 ) != PointIndex.end() )
-            return true;
+        const TriangleData& tri = m_Triangles[i];
         
-        if( PointIndex.find( tri.index2 ) != PointIndex.end() )
-            return true;
+        for( int j = 0; j < 3; ++j ) {
+            if( tri.neighbor[j] == NO_NEIGHBOR ) {
+                pEdge->push_back( m_PointIndex[tri.index[( j + 1 ) % 3]] );
+                pEdge->push_back( m_PointIndex[tri.index[( j + 2 ) % 3]] );
+            }
+        }
+    }
+}
+
+template< typename Scalar, typename Index, typename Predicate >
+void Delaunay< Scalar, Index, Predicate >::GetTriangleOrder( std::vector< Index > *pOrder ) const
+{
+    Index count = 0;
+    
+    pOrder->assign( m_Triangles.size(), NO_NEIGHBOR );
+    
+    for( Index i = 0; i < m_Triangles.size(); ++i ) {
+        if( m_TriangleAlive[i] ) {
+            (*pOrder)[i] = count++;
+        }
+    }
+}
+
+// One walk around every vertex, so linear in the size of the mesh
+template< typename Scalar, typename Index, typename Predicate >
+void Delaunay< Scalar, Index, Predicate >::GetVoronoi( std::vector< Point > *pVertex, std::vector< Index > *pCellOffset, std::vector< Index > *pCell, std::vector< Point > *pRay ) const
+{
+    std::vector< Index > order;
+    Index id, vertex;
+    
+    pVertex->clear();
+    pCell->clear();
+    pCellOffset->assign( m_PointIndex.size() + 1, 0 );
+    pRay->assign( 2 * m_PointIndex.size(), Point::Zero() );
+    
+    if( m_Stream )
+        return;
+    
+    GetTriangleOrder( &order );
+    pVertex->reserve( GetTriangleCount() );
+    pCell->reserve( 3 * GetTriangleCount() );
+    
+    for( Index i = 0; i < m_Triangles.size(); ++i ) {
+        if( m_TriangleAlive[i] ) {
+            const TriangleData& tri = m_Triangles[i];
+            pVertex->push_back( Predicates::Circumcenter( ToDouble( m_Points[tri.index[0]] ), ToDouble( m_Points[tri.index[1]] ),
+                                                          ToDouble( m_Points[tri.index[2]] ) ).template cast< Scalar >() );
+        }
+    }
+    
+    for( id = 0; id < m_PointIndex.size(); ++id ) {
+        vertex = m_PointVertex[id];
+        (*pCellOffset)[id] = pCell->size();
         
-        if( PointIndex.find( tri.index3 ) != PointIndex.end() )
-            return true;
+        if( vertex < m_VertexLink.size() && m_VertexLink[vertex] != NO_NEIGHBOR ) {
+            GetVoronoiCell( vertex, order, pCell, &(*pRay)[2 * id] );
+        }
+    }
+    
+    (*pCellOffset)[id] = pCell->size();
+}
+
+// The circumcenters of the triangles around vertex counterclockwise. An open star starts at
+// the hull edge to the next hull vertex and ends at the one from the previous, the rays are
+// the outward normals of these edges.
+template< typename Scalar, typename Index, typename Predicate >
+void Delaunay< Scalar, Index, Predicate >::GetVoronoiCell( Index vertex, const std::vector< Index >& order, std::vector< Index > *pCell, Point *pRay ) const
+{
+    const Eigen::Vector2d point = ToDouble( m_Points[vertex] );
+    Index start, current, next;
+    int i;
+    
+    start = current = m_VertexLink[vertex];
+    for( i = 0; m_Triangles[current].index[i] != vertex; ++i );
+    
+    do {
+        next = m_Triangles[current].neighbor[( i + 2 ) % 3];
         
-        return false;
+        if( next == NO_NEIGHBOR ) {
+            Eigen::Vector2d edge = ToDouble( m_Points[m_Triangles[current].index[( i + 1 ) % 3]] ) - point;
+            pRay[0] = Eigen::Vector2d( edge.y(), -edge.x() ).normalized().template cast< Scalar >();
+            break;
+        }
+        
+        current = next;
+        for( i = 0; m_Triangles[current].index[i] != vertex; ++i );
+    } while( current != start );
+    
+    start = current;
+    
+    for( ;; ) {
+        pCell->push_back( order[current] );
+        next = m_Triangles[current].neighbor[( i + 1 ) % 3];
+        
+        if( next == NO_NEIGHBOR ) {
+            Eigen::Vector2d edge = point - ToDouble( m_Points[m_Triangles[current].index[( i + 2 ) % 3]] );
+            pRay[1] = Eigen::Vector2d( edge.y(), -edge.x() ).normalized().template cast< Scalar >();
+            break;
+        }
+        
+        if( next == start )
+            break;
         
-    }), end( m_Triangles ) );
+        current = next;
+        for( i = 0; m_Triangles[current].index[i] != vertex; ++i );
+    }
+}
+
+// Open cells are closed far away first, through a point along the bisector of their rays so that
+// no closing edge comes near the box, then every cell is clipped against the four sides in turn
+template< typename Scalar, typename Index, typename Predicate >
+void Delaunay< Scalar, Index, Predicate >::GetVoronoi( const Point& min, const Point& max, std::vector< Point > *pCellPoint, std::vector< Index > *pCellOffset ) const
+{
+    std::vector< Point > vertex, ray;
+    std::vector< Index > offset, cell;
+    std::vector< Eigen::Vector2d > polygon, clipped;
+    Eigen::Vector2d lower = ToDouble( min ), upper = ToDouble( max );
+    Index id, k;
+    int side;
+    
+    GetVoronoi( &vertex, &offset, &cell, &ray );
+    
+    for( auto point : vertex ) {
+        lower = lower.cwiseMin( ToDouble( point ) );
+        upper = upper.cwiseMax( ToDouble( point ) );
+    }
+    
+    const double far = 4.0 * ( upper - lower ).norm() + 1.0;
+    
+    pCellPoint->clear();
+    pCellOffset->assign( m_PointIndex.size() + 1, 0 );
+    
+    for( id = 0; id < m_PointIndex.size(); ++id ) {
+        (*pCellOffset)[id] = pCellPoint->size();
+        polygon.clear();
+        
+        for( k = offset[id]; k < offset[id + 1]; ++k ) {
+            polygon.push_back( ToDouble( vertex[cell[k]] ) );
+        }
+        
+        if( polygon.empty() )
+            continue;
+        
+        if( ray[2 * id] != Point::Zero() ) {
+            const Eigen::Vector2d out = ToDouble( ray[2 * id + 1] ), in = ToDouble( ray[2 * id] );
+            Eigen::Vector2d bisector = out + in;
+            
+            // The rays turn counterclockwise from out to in, by at most a half turn
+            if( bisector.squaredNorm() < 1e-12 ) {
+                bisector = Eigen::Vector2d( -out.y(), out.x() );
+            }
+            
+            const Eigen::Vector2d first = polygon.front(), last = polygon.back();
+            
+            polygon.push_back( last + far * out );
+            polygon.push_back( 0.5 * ( first + last ) + far * bisector.normalized() );
+            polygon.push_back( first + far * in );
+        }
+        
+        // Sutherland-Hodgman, side 0 to 3 keep x >= min, y >= min, x <= max and y <= max
+        for( side = 0; side < 4 && !polygon.empty(); ++side ) {
+            const int axis = side % 2;
+            const double bound = ( side < 2 ) ? ToDouble( min )[axis] : ToDouble( max )[axis];
+            const double sign = ( side < 2 ) ? 1.0 : -1.0;
+            
+            clipped.clear();
+            
+            for( k = 0; k < polygon.size(); ++k ) {
+                const Eigen::Vector2d& a = polygon[k];
+                const Eigen::Vector2d& b = polygon[( k + 1 ) % polygon.size()];
+                double da = sign * ( a[axis] - bound ), db = sign * ( b[axis] - bound );
+                
+                if( da >= 0.0 ) {
+                    clipped.push_back( a );
+                }
+                
+                if( ( da >= 0.0 ) != ( db >= 0.0 ) ) {
+                    clipped.push_back( a + ( da / ( da - db ) ) * ( b - a ) );
+                }
+            }
+            
+            polygon.swap( clipped );
+        }
+        
+        for( auto point : polygon ) {
+            pCellPoint->push_back( point.template cast< Scalar >() );
+        }
+    }
     
-    for( auto index = m_InitTrianglePointIndex.rbegin(); index != m_InitTrianglePointIndex.rend(); ++index ) {
-        m_Points.erase( m_Points.begin() + *index );
+    (*pCellOffset)[id] = pCellPoint->size();
+}
+
+static unsigned long long HilbertIndex( unsigned long x, unsigned long y )
+{
+    const unsigned long n = 1ul << 16;
+    unsigned long long d = 0;
+    unsigned long s, rx, ry, t;
+    
+    for( s = n >> 1; s > 0; s >>= 1 ) {
+        rx = ( x & s ) ? 1 : 0;
+        ry = ( y & s ) ? 1 : 0;
+        d += static_cast< unsigned long long >( s ) * s * ( ( 3 * rx ) ^ ry );
+        
+        if( ry == 0 ) {
+            if( rx == 1 ) {
+                x = n - 1 - x;
+                y = n - 1 - y;
+            }
+            t = x;
+            x = y;
+            y = t;
+        }
     }
     
+    return d;
 }
 
-void Delaunay::AddTriangle( unsigned long index1, unsigned long index2, unsigned long index3 )
+template< typename Scalar, typename Index, typename Predicate >
+void Delaunay< Scalar, Index, Predicate >::SortPoint( const Scalar *pCoordinate, Index PointSize, Index stride, InsertionOrder order, std::vector< Index > *pIndex )
 {
-    Eigen::Vector2d p1 = m_Points[index1];
-    Eigen::Vector2d p2 = m_Points[index2];
-    Eigen::Vector2d p3 = m_Points[index3];
+    Index i;
+    
+    pIndex->resize( PointSize );
     
-    Eigen::MatrixXd A(2,2);
-    Eigen::VectorXd b(2);
+    for( i = 0; i < PointSize; ++i ) {
+        (*pIndex)[i] = i;
+    }
+    
+    // A walk from the last triangle needs each point close to the one before, points in input
+    // order still go along the Hilbert curve. The stable sort keeps their order within a cell.
+    if( PointSize < 3 || ( order == INPUT_ORDER && m_Engine == DIVIDE_AND_CONQUER ) )
+        return;
+    
+    DELAUNAY_STATS_PHASE( SORT_POINT );
+    
+    Point min( pCoordinate[0], pCoordinate[1] ), max = min;
+    
+    for( i = 0; i < PointSize; ++i ) {
+        Point point( pCoordinate[i * stride], pCoordinate[i * stride + 1] );
+        min = min.cwiseMin( point );
+        max = max.cwiseMax( point );
+    }
+    
+    Eigen::Vector2d scale = ( max - min ).template cast< double >();
+    scale.x() = ( scale.x() > 0.0 ) ? 65535.0 / scale.x() : 0.0;
+    scale.y() = ( scale.y() > 0.0 ) ? 65535.0 / scale.y() : 0.0;
+    
+    // The key holds the Hilbert index in its low 32 bits and, for BRIO, the round in the high bits
+    std::vector< unsigned long long >& keys = m_SortKey;
+    keys.resize( PointSize );
+    unsigned long long round;
+    unsigned long long seed = 2;
+    
+    for( i = 0; i < PointSize; ++i ) {
+        Point point( pCoordinate[i * stride], pCoordinate[i * stride + 1] );
+        keys[i] = HilbertIndex( static_cast< unsigned long >( ( point.x() - min.x() ) * scale.x() ),
+                                static_cast< unsigned long >( ( point.y() - min.y() ) * scale.y() ) );
+        
+        if( order == BRIO_ORDER ) {
+            // Each point survives into the next earlier round with probability 1/2
+            seed = seed * 6364136223846793005ull + 1442695040888963407ull;
+            
+            for( round = 31; round > 0 && ( ( seed >> ( 63 - round ) ) & 1 ); --round );
+            
+            keys[i] |= round << 32;
+        }
+    }
+    
+    if( order == INPUT_ORDER ) {
+        std::stable_sort( pIndex->begin(), pIndex->end(), [&keys]( Index a, Index b ) {
+            return keys[a] < keys[b];
+        });
+        return;
+    }
+    
+    std::sort( pIndex->begin(), pIndex->end(), [&keys]( Index a, Index b ) {
+        return keys[a] < keys[b];
+    });
+}
+
+static const unsigned long MIN_PARALLEL_MERGE = 65536;
+
+// Runs function( begin, end ) on threadCount slices of [ 0, count ), the first on the calling thread
+template< typename Function >
+static void ParallelFor( unsigned int threadCount, size_t count, Function function )
+{
+    std::vector< std::thread > worker;
+    size_t step = ( count + threadCount - 1 ) / threadCount;
     
-    A( 0, 0 ) = 2.0 * ( p2.x() - p1.x() );
-    A( 0, 1 ) = 2.0 * ( p2.y() - p1.y() );
-    A( 1, 0 ) = 2.0 * ( p3.x() - p1.x() );
-    A( 1, 1 ) = 2.0 * ( p3.y() - p1.y() );
+    for( size_t begin = step; begin < count; begin += step ) {
+        worker.push_back( std::thread( function, begin, std::min( begin + step, count ) ) );
+    }
     
-    b(0) = - p1.x() * p1.x() + p2.x() * p2.x() - p1.y() * p1.y() + p2.y() * p2.y();
-    b(1) = - p1.x() * p1.x() + p3.x() * p3.x() - p1.y() * p1.y() + p3.y() * p3.y();
+    function( 0, std::min( step, count ) );
     
-    Eigen::VectorXd x = A.fullPivLu().solve(b);
+    for( auto& thread : worker ) {
+        thread.join();
+    }
+}
 
-    TriangleData triangle;
-    triangle.index1 = index1;
-    triangle.index2 = index2;
-    triangle.index3 = index3;
-    triangle.center[0] = x[0];
-    triangle.center[1] = x[1];
-    triangle.radius = ( triangle.center - p1 ).norm();
+static size_t CellBucket( long long x, long long y, size_t mask )
+{
+    unsigned long long hash = static_cast< unsigned long long >( x ) * 0x9e3779b97f4a7c15ull ^ static_cast< unsigned long long >( y ) * 0xc2b2ae3d27d4eb4full;
     
-    triangle.bounds[0] = triangle.center.x() - triangle.radius;
-    triangle.bounds[1] = triangle.center.x() + triangle.radius;
-    triangle.bounds[2] = triangle.center.y() - triangle.radius;
-    triangle.bounds[3] = triangle.center.y() + triangle.radius;
+    return static_cast< size_t >( hash ^ ( hash >> 29 ) ) & mask;
+}
 
-    this->m_Triangles.push_back( triangle );
+// Squared distance from p to the segment from a to b
+static double SegmentDistance( const Eigen::Vector2d& a, const Eigen::Vector2d& b, const Eigen::Vector2d& p )
+{
+    const Eigen::Vector2d ab = b - a;
+    const double length = ab.squaredNorm();
+    const double t = ( length > 0.0 ) ? std::max( 0.0, std::min( 1.0, ( p - a ).dot( ab ) / length ) ) : 0.0;
+    
+    return ( a + t * ab - p ).squaredNorm();
 }
 
-void Delaunay::Triangulation()
+// Greedy in id order over a hash grid with cells of the merge distance, so the points within
+// reach of a point lie in its 3 x 3 block of cells. The test for any nearer point with a lower
+// id runs in parallel, only the points that have one are decided in order afterwards.
+template< typename Scalar, typename Index, typename Predicate >
+void Delaunay< Scalar, Index, Predicate >::MergePoint( const Scalar *pCoordinate, Index PointSize, Index stride, std::vector< Index > *pMergeId ) const
 {
-    CreateInitTriangle();
+    std::vector< Index >& merge = *pMergeId;
     
-    std::vector< Eigen::Vector2d >::iterator itPoint;
-    std::vector< EdgeData >::iterator itEdge1, itEdge2;
-    unsigned long index, PointCount;
-    bool check;
+    merge.clear();
     
-    PointCount = m_Points.size() - m_InitTrianglePointIndex.size();
+    if( !( m_MergeDistance > 0 ) || PointSize == 0 )
+        return;
     
-    for( index = 0, itPoint = m_Points.begin(); index < PointCount; ++index, ++itPoint ) {
-        
-        std::vector< TriangleData > triangles;
-        std::vector< EdgeData > edges;
+    const double size = m_MergeDistance;
+    const double distance = size * size;
+    const unsigned int threadCount = ( PointSize >= MIN_PARALLEL_MERGE ) ? m_ThreadCount : 1;
+    size_t mask, k;
+    Index i;
+    
+    for( mask = 1; mask < PointSize; mask <<= 1 );
+    
+    std::vector< size_t > first( mask + 1, 0 );
+    std::vector< size_t > bucket( PointSize );
+    std::vector< Index > member( PointSize );
+    --mask;
+    
+    auto cell = [&]( Index i, long long *pX, long long *pY ) {
+        *pX = static_cast< long long >( std::floor( pCoordinate[i * stride] / size ) );
+        *pY = static_cast< long long >( std::floor( pCoordinate[i * stride + 1] / size ) );
+    };
+    
+    ParallelFor( threadCount, PointSize, [&]( size_t begin, size_t end ) {
+        long long x, y;
         
-        for( auto tri : m_Triangles ) {
-            if( tri.IsInside( *itPoint ) ) {
-                edges.push_back( EdgeData( tri.index1, tri.index2 ) );
-                edges.push_back( EdgeData( tri.index2, tri.index3 ) );
-                edges.push_back( EdgeData( tri.index3, tri.index1 ) );
-            } else {
-                triangles.push_back( tri );
-            }
+        for( size_t i = begin; i < end; ++i ) {
+            cell( i, &x, &y );
+            bucket[i] = CellBucket( x, y, mask );
         }
+    });
+    
+    // Counting sort by bucket, the members of a bucket stay in id order
+    for( i = 0; i < PointSize; ++i ) {
+        ++first[bucket[i] + 1];
+    }
+    
+    for( k = 0; k < mask + 1; ++k ) {
+        first[k + 1] += first[k];
+    }
+    
+    for( i = 0; i < PointSize; ++i ) {
+        member[first[bucket[i]]++] = i;
+    }
+    
+    for( k = mask + 1; k > 0; --k ) {
+        first[k] = first[k - 1];
+    }
+    
+    first[0] = 0;
+    
+    // The lowest id below i within the distance, only counting kept points when asked to
+    auto search = [&]( Index i, bool kept ) {
+        const double px = pCoordinate[i * stride];
+        const double py = pCoordinate[i * stride + 1];
+        Index found = NO_NEIGHBOR;
+        long long x, y, dx, dy;
         
-        m_Triangles.resize( triangles.size() );
-        std::copy( triangles.begin(), triangles.end(), m_Triangles.begin() );
+        cell( i, &x, &y );
         
-        std::sort( edges.begin(), edges.end(), []( EdgeData a, EdgeData b ) {
-            if( a.index1 < b.index1 ) {
-                return true;
-            } else if( a.index1 == b.index1 ) {
-                if( a.index2 < b.index2 ) {
-                    return true;
-                } else {
-                    return false;
+        for( dx = -1; dx <= 1; ++dx ) {
+            for( dy = -1; dy <= 1; ++dy ) {
+                size_t b = CellBucket( x + dx, y + dy, mask );
+                
+                for( size_t m = first[b]; m < first[b + 1] && member[m] < std::min( i, found ); ++m ) {
+                    Index j = member[m];
+                    double ex = pCoordinate[j * stride] - px;
+                    double ey = pCoordinate[j * stride + 1] - py;
+                    
+                    if( ex * ex + ey * ey <= distance && ( !kept || merge[j] == j ) ) {
+                        found = j;
+                        break;
+                    }
                 }
-            } else {
-                return false;
             }
-        });
+        }
         
-        for( itEdge1 = edges.begin(), itEdge2 = edges.begin() + 1, check = true; itEdge2 != edges.end(); ++itEdge1, ++itEdge2 ) {
-            if( (*itEdge1).index1 == (*itEdge2).index1 && (*itEdge1).index2 == (*itEdge2).index2 ) {
-                check = false;
-            } else {
-                if( check ) {
-                    AddTriangle( (*itEdge1).index1, (*itEdge1).index2, index );
-                }
-                check = true;
+        return found;
+    };
+    
+    merge.resize( PointSize );
+    
+    ParallelFor( threadCount, PointSize, [&]( size_t begin, size_t end ) {
+        for( size_t i = begin; i < end; ++i ) {
+            merge[i] = ( search( i, false ) == NO_NEIGHBOR ) ? i : NO_NEIGHBOR;
+        }
+    });
+    
+    for( i = 0; i < PointSize; ++i ) {
+        if( merge[i] == NO_NEIGHBOR ) {
+            Index j = search( i, true );
+            merge[i] = ( j == NO_NEIGHBOR ) ? i : j;
+        }
+    }
+}
+
+// The new points with an existing point in reach merge into it, as existing ids are all lower.
+// The others go through MergePoint among themselves. Searched in the given order, so that
+// each walk starts where the one before ended.
+template< typename Scalar, typename Index, typename Predicate >
+void Delaunay< Scalar, Index, Predicate >::MergeInsertedPoint( const Scalar *pCoordinate, Index stride, const std::vector< Index >& order )
+{
+    if( !( m_MergeDistance > 0 ) || order.empty() )
+        return;
+    
+    const Index id = m_PointIndex.size();
+    const Index start = m_LastTriangle;
+    std::vector< Index > local, merge;
+    std::vector< Scalar > coordinate;
+    Index k;
+    
+    // Points that were there before any merge distance was set kept their own ids
+    for( k = m_MergeId.size(); k < id; ++k ) {
+        m_MergeId.push_back( k );
+    }
+    
+    m_MergeId.resize( id + order.size() );
+    
+    for( auto index : order ) {
+        m_MergeId[id + index] = FindMergeTarget( Point( pCoordinate[index * stride], pCoordinate[index * stride + 1] ) );
+    }
+    
+    m_LastTriangle = start;
+    
+    for( k = 0; k < order.size(); ++k ) {
+        if( m_MergeId[id + k] == NO_NEIGHBOR ) {
+            local.push_back( k );
+            coordinate.push_back( pCoordinate[k * stride] );
+            coordinate.push_back( pCoordinate[k * stride + 1] );
+        }
+    }
+    
+    MergePoint( coordinate.data(), local.size(), 2, &merge );
+    
+    for( k = 0; k < local.size(); ++k ) {
+        m_MergeId[id + local[k]] = id + local[merge[k]];
+    }
+}
+
+// The lowest id of a mesh vertex within the merge distance. Each of them is the corner of a
+// triangle that meets the disk around the point, and these triangles are connected across
+// edges that meet it too, so a search from the triangle holding the point finds them all.
+template< typename Scalar, typename Index, typename Predicate >
+Index Delaunay< Scalar, Index, Predicate >::FindMergeTarget( const Point& point )
+{
+    const Eigen::Vector2d p = ToDouble( point );
+    const double distance = static_cast< double >( m_MergeDistance ) * m_MergeDistance;
+    Index found = NO_NEIGHBOR;
+    Index vertex, current, next, k;
+    int i;
+    
+    auto visit = [&]( Index v ) {
+        if( ( ToDouble( m_Points[v] ) - p ).squaredNorm() <= distance ) {
+            found = std::min( found, m_PointIndex[v] );
+        }
+    };
+    
+    // Without a mesh the points are too few or on a line, all of them are looked at
+    if( GetTriangleCount() == 0 ) {
+        for( vertex = 0; vertex < m_Points.size(); ++vertex ) {
+            Index id = m_PointIndex[vertex];
+            
+            if( m_MergeId[id] == id && std::find( m_RemovedVertex.begin(), m_RemovedVertex.end(), vertex ) == m_RemovedVertex.end() ) {
+                visit( vertex );
             }
         }
         
-        itEdge1 = edges.begin() + edges.size() - 2;
-        itEdge2 = edges.begin() + edges.size() - 1;
+        return found;
+    }
+    
+    const Index mark = NextMark();
+    
+    current = LocatePoint( point );
+    m_LastTriangle = current;
+    m_NearTriangle.clear();
+    
+    // From outside of the hull the disk comes in through one of the hull edges the point sees
+    for( i = 0; i < 3; ++i ) {
+        const TriangleData& triangle = m_Triangles[current];
+        
+        if( triangle.neighbor[i] == NO_NEIGHBOR &&
+            Predicate::Orientation( ToDouble( m_Points[triangle.index[( i + 1 ) % 3]] ), ToDouble( m_Points[triangle.index[( i + 2 ) % 3]] ), p ) < 0.0 ) {
+            FindHullEdge( p, current, i );
+            break;
+        }
+    }
+    
+    if( i == 3 ) {
+        m_TriangleMark[current] = mark;
+        m_NearTriangle.push_back( current );
+    }
+    
+    for( auto edge : m_HullEdge ) {
+        if( m_TriangleMark[edge.first] != mark ) {
+            m_TriangleMark[edge.first] = mark;
+            m_NearTriangle.push_back( edge.first );
+        }
+    }
+    
+    m_HullEdge.clear();
+    
+    for( k = 0; k < m_NearTriangle.size(); ++k ) {
+        const TriangleData& tri = m_Triangles[m_NearTriangle[k]];
         
-        if( !( (*itEdge1).index1 == (*itEdge2).index1 && (*itEdge1).index2 == (*itEdge2).index2 ) ) {
-            AddTriangle( (*itEdge2).index1, (*itEdge2).index2, index );
+        for( i = 0; i < 3; ++i ) {
+            visit( tri.index[i] );
+            next = tri.neighbor[i];
+            
+            // Twice the distance leaves room for rounding, a few more triangles do no harm
+            if( next != NO_NEIGHBOR && m_TriangleMark[next] != mark &&
+                SegmentDistance( ToDouble( m_Points[tri.index[( i + 1 ) % 3]] ), ToDouble( m_Points[tri.index[( i + 2 ) % 3]] ), p ) <= 2.0 * distance ) {
+                m_TriangleMark[next] = mark;
+                m_NearTriangle.push_back( next );
+            }
         }
+    }
+    
+    return found;
+}
+
+// The first triangle is made of input points, the outer face around it stands for the
+// infinite vertex, so there are no extra points to remove and nothing to filter at the end
+template< typename Scalar, typename Index, typename Predicate >
+void Delaunay< Scalar, Index, Predicate >::CreateInitTriangle()
+{
+    DELAUNAY_STATS_PHASE( CREATE_INIT_TRIANGLE );
+    
+    Index PointSize = m_Points.size();
+    Index index1, index2, index3;
+    double orientation = 0.0;
+    
+    m_Triangles.clear();
+    m_TriangleAlive.clear();
+    m_TriangleMark.clear();
+    m_FreeTriangle.clear();
+    m_Mark = 0;
+    m_VertexLink.assign( PointSize, NO_NEIGHBOR );
+    m_LastTriangle = NO_NEIGHBOR;
+    
+    // n points never need more than 2n - 5 triangles
+    m_Triangles.reserve( 2 * PointSize );
+    m_TriangleAlive.reserve( 2 * PointSize );
+    m_TriangleMark.reserve( 2 * PointSize );
+    
+    // The points come in insertion order, the first two distinct ones and the first point
+    // off their line span the triangle. Collinear input has none.
+    index1 = 0;
+    
+    for( index2 = 1; index2 < PointSize && m_Points[index2] == m_Points[index1]; ++index2 );
+    
+    for( index3 = index2 + 1; index3 < PointSize; ++index3 ) {
+        orientation = Predicate::Orientation( ToDouble( m_Points[index1] ), ToDouble( m_Points[index2] ), ToDouble( m_Points[index3] ) );
+        
+        if( orientation != 0.0 )
+            break;
+    }
+    
+    if( index3 >= PointSize )
+        return;
+    
+    if( orientation < 0.0 ) {
+        std::swap( index2, index3 );
+    }
+    
+    m_LastTriangle = AddTriangle( index1, index2, index3 );
+    m_VertexLink[index1] = m_VertexLink[index2] = m_VertexLink[index3] = m_LastTriangle;
+    DELAUNAY_STATS_COUNT( triangleCreated, 1 );
+}
+
+template< typename Scalar, typename Index, typename Predicate >
+void Delaunay< Scalar, Index, Predicate >::LinkVertex()
+{
+    m_VertexLink.assign( m_Points.size(), NO_NEIGHBOR );
+    
+    for( Index i = 0; i < m_Triangles.size(); ++i ) {
+        if( !m_TriangleAlive[i] )
+            continue;
         
+        m_VertexLink[m_Triangles[i].index[0]] = i;
+        m_VertexLink[m_Triangles[i].index[1]] = i;
+        m_VertexLink[m_Triangles[i].index[2]] = i;
+    }
+}
+
+template< typename Scalar, typename Index, typename Predicate >
+Index Delaunay< Scalar, Index, Predicate >::AllocateTriangle()
+{
+    if( !m_FreeTriangle.empty() ) {
+        Index triangle = m_FreeTriangle.back();
+        m_FreeTriangle.pop_back();
+        m_TriangleAlive[triangle] = true;
+        return triangle;
     }
     
-    DeleteInitTriangle();
+    m_Triangles.push_back( TriangleData() );
+    m_TriangleAlive.push_back( true );
+    m_TriangleMark.push_back( 0 );
     
+    return m_Triangles.size() - 1;
+}
+
+template< typename Scalar, typename Index, typename Predicate >
+void Delaunay< Scalar, Index, Predicate >::FreeTriangle( Index triangle )
+{
+    m_TriangleAlive[triangle] = false;
+    m_FreeTriangle.push_back( triangle );
 }
+
+template< typename Scalar, typename Index, typename Predicate >
+Index Delaunay< Scalar, Index, Predicate >::AddTriangle( Index index1, Index index2, Index index3 )
+{
+    Index triangle = AllocateTriangle();
+    
+    TriangleData& tri = m_Triangles[triangle];
+    tri.index[0] = index1;
+    tri.index[1] = index2;
+    tri.index[2] = index3;
+    tri.neighbor[0] = tri.neighbor[1] = tri.neighbor[2] = NO_NEIGHBOR;
+    
+    return triangle;
+}
+
+template< typename Scalar, typename Index, typename Predicate >
+Index Delaunay< Scalar, Index, Predicate >::LocatePoint( const Point& point )
+{
+    Index current = m_LastTriangle;
+    Index previous = NO_NEIGHBOR;
+    Index seed = current;
+    int i, k, start;
+    bool moved;
+#ifdef DELAUNAY_STATS
+    unsigned long length = 0;
+#endif
+    
+    do {
+        const TriangleData& tri = m_Triangles[current];
+        
+        seed = seed * 1103515245ul + 12345ul;
+        start = static_cast< int >( ( seed >> 16 ) % 3 );
+        moved = false;
+        
+        for( k = 0; k < 3; ++k ) {
+            i = ( start + k ) % 3;
+            
+            if( tri.neighbor[i] == NO_NEIGHBOR || tri.neighbor[i] == previous )
+                continue;
+            
+            if( Predicate::Orientation( ToDouble( m_Points[tri.index[( i + 1 ) % 3]] ), ToDouble( m_Points[tri.index[( i + 2 ) % 3]] ), ToDouble( point ) ) < 0.0 ) {
+                previous = current;
+                current = tri.neighbor[i];
+                moved = true;
+#ifdef DELAUNAY_STATS
+                ++length;
+#endif
+                break;
+            }
+        }
+        
+    } while( moved );
+    
+    DELAUNAY_STATS_HISTOGRAM( walkLength, length );
+    
+    return current;
+}
+
+// Linear search over the live triangles, for a walk that ran into a finalized region. Gives
+// the triangle holding the point with side -1, or else one with a hull edge the point sees.
+template< typename Scalar, typename Index, typename Predicate >
+Index Delaunay< Scalar, Index, Predicate >::FindTriangle( const Point& point, int *pSide )
+{
+    const Eigen::Vector2d p = ToDouble( point );
+    Index hull = NO_NEIGHBOR;
+    int i, side = -1, outside;
+    
+    for( Index tri = 0; tri < m_Triangles.size(); ++tri ) {
+        if( !m_TriangleAlive[tri] )
+            continue;
+        
+        const TriangleData& triangle = m_Triangles[tri];
+        
+        for( i = 0, outside = 0; i < 3; ++i ) {
+            if( Predicate::Orientation( ToDouble( m_Points[triangle.index[( i + 1 ) % 3]] ), ToDouble( m_Points[triangle.index[( i + 2 ) % 3]] ), p ) < 0.0 ) {
+                ++outside;
+                
+                if( hull == NO_NEIGHBOR && IsHullEdge( tri, i ) ) {
+                    hull = tri;
+                    side = i;
+                }
+            }
+        }
+        
+        if( outside == 0 ) {
+            *pSide = -1;
+            return tri;
+        }
+    }
+    
+    *pSide = side;
+    
+    return ( hull != NO_NEIGHBOR ) ? hull : m_LastTriangle;
+}
+
+// Every cavity search needs three fresh mark values, all marks are cleared when they run out
+template< typename Scalar, typename Index, typename Predicate >
+Index Delaunay< Scalar, Index, Predicate >::NextMark()
+{
+    if( m_Mark >= NO_NEIGHBOR - 3 ) {
+        std::fill( m_TriangleMark.begin(), m_TriangleMark.end(), 0 );
+        m_Mark = 0;
+    }
+    
+    m_Mark += 3;
+    
+    return m_Mark - 2;
+}
+
+template< typename Scalar, typename Index, typename Predicate >
+void Delaunay< Scalar, Index, Predicate >::AddCavityEdge( Index triangle, int side )
+{
+    const TriangleData& tri = m_Triangles[triangle];
+    CavityEdgeData edge;
+    
+    edge.index1 = tri.index[( side + 1 ) % 3];
+    edge.index2 = tri.index[( side + 2 ) % 3];
+    edge.outer = tri.neighbor[side];
+    
+    m_CavityBoundary.push_back( edge );
+}
+
+template< typename Scalar, typename Index, typename Predicate >
+void Delaunay< Scalar, Index, Predicate >::FindCavity( const Point& point, Index start )
+{
+    const Index inside = NextMark();
+    const Index outside = inside + 1;
+    const Index pending = inside + 2;
+    Index begin, end, current, next, count, k;
+    int i;
+    
+    m_Cavity.clear();
+    m_CavityBoundary.clear();
+    
+    if( start != NO_NEIGHBOR ) {
+        m_TriangleMark[start] = inside;
+        m_Cavity.push_back( start );
+    }
+    
+    // The infinite triangle beyond a hull edge the point sees is in conflict with it. The
+    // triangle inside takes the usual test and the edge seen from outside bounds the cavity.
+    for( auto edge : m_HullEdge ) {
+        const TriangleData& tri = m_Triangles[edge.first];
+        
+        DELAUNAY_STATS_COUNT( inCircleCount, 1 );
+        
+        if( Predicate::InCircle( ToDouble( m_Points[tri.index[0]] ), ToDouble( m_Points[tri.index[1]] ), ToDouble( m_Points[tri.index[2]] ), ToDouble( point ) ) > 0.0 ) {
+            if( m_TriangleMark[edge.first] != inside ) {
+                m_TriangleMark[edge.first] = inside;
+                m_Cavity.push_back( edge.first );
+            }
+        } else {
+            CavityEdgeData outer;
+            
+            outer.index1 = tri.index[( edge.second + 2 ) % 3];
+            outer.index2 = tri.index[( edge.second + 1 ) % 3];
+            outer.outer = edge.first;
+            
+            m_TriangleMark[edge.first] = outside;
+            m_CavityBoundary.push_back( outer );
+        }
+    }
+    
+    // Breadth-first expansion one level at a time. The untested neighbours of a level are
+    // gathered as structure-of-arrays coordinates and go through one batched in-circle test.
+    for( begin = 0; begin < m_Cavity.size(); begin = end ) {
+        end = m_Cavity.size();
+        
+        m_BatchTriangle.clear();
+        m_BatchEdge.clear();
+        
+        for( k = begin; k < end; ++k ) {
+            current = m_Cavity[k];
+            
+            for( i = 0; i < 3; ++i ) {
+                next = m_Triangles[current].neighbor[i];
+                
+                // The cavity does not reach across a segment
+                if( next != NO_NEIGHBOR && !m_Constraint.empty() &&
+                    IsConstraint( m_Triangles[current].index[( i + 1 ) % 3], m_Triangles[current].index[( i + 2 ) % 3] ) ) {
+                    AddCavityEdge( current, i );
+                    continue;
+                }
+                
+                if( next != NO_NEIGHBOR && m_TriangleMark[next] != outside ) {
+                    if( m_TriangleMark[next] == inside )
+                        continue;
+                    
+                    if( m_TriangleMark[next] != pending ) {
+                        m_TriangleMark[next] = pending;
+                        m_BatchTriangle.push_back( next );
+                    }
+                    
+                    m_BatchEdge.push_back( std::make_pair( current, i ) );
+                    continue;
+                }
+                
+                // So is the infinite triangle behind a hull edge the point sees
+                if( next == NO_NEIGHBOR && !m_HullEdge.empty() &&
+                    std::find( m_HullEdge.begin(), m_HullEdge.end(), std::make_pair( current, i ) ) != m_HullEdge.end() )
+                    continue;
+                
+                AddCavityEdge( current, i );
+            }
+        }
+        
+        count = m_BatchTriangle.size();
+        m_BatchCoordinate.resize( 6 * count );
+        
+        double *coordinate = m_BatchCoordinate.data();
+        
+        for( k = 0; k < count; ++k ) {
+            const TriangleData& tri = m_Triangles[m_BatchTriangle[k]];
+            
+            for( i = 0; i < 3; ++i ) {
+                coordinate[( 2 * i ) * count + k]     = m_Points[tri.index[i]].x();
+                coordinate[( 2 * i + 1 ) * count + k] = m_Points[tri.index[i]].y();
+            }
+        }
+        
+        m_BatchResult.resize( count );
+        DELAUNAY_STATS_COUNT( inCircleCount, count );
+        
+        Predicate::InCircleBatch( ToDouble( point ), count, coordinate, coordinate + count, coordinate + 2 * count,
+                                  coordinate + 3 * count, coordinate + 4 * count, coordinate + 5 * count, m_BatchResult.data() );
+        
+        for( k = 0; k < count; ++k ) {
+            next = m_BatchTriangle[k];
+            
+            if( m_BatchResult[k] > 0.0 ) {
+                m_TriangleMark[next] = inside;
+                m_Cavity.push_back( next );
+            } else {
+                m_TriangleMark[next] = outside;
+            }
+        }
+        
+        for( auto edge : m_BatchEdge ) {
+            if( m_TriangleMark[m_Triangles[edge.first].neighbor[edge.second]] == outside ) {
+                AddCavityEdge( edge.first, edge.second );
+            }
+        }
+    }
+    
+    DELAUNAY_STATS_HISTOGRAM( cavitySize, m_Cavity.size() );
+}
+
+template< typename Scalar, typename Index, typename Predicate >
+void Delaunay< Scalar, Index, Predicate >::InsertVertex( Index index )
+{
+    const Point point = m_Points[index];
+    Index current, next, tri, k, count, segment1, segment2;
+    int i, j;
+    
+    current = LocatePoint( point );
+    
+    // The walk stops at the hull when the point lies outside of it, or when streaming
+    // at the edge of a finalized region
+    for( i = 0; i < 3; ++i ) {
+        const TriangleData& triangle = m_Triangles[current];
+        
+        if( triangle.neighbor[i] == NO_NEIGHBOR &&
+            Predicate::Orientation( ToDouble( m_Points[triangle.index[( i + 1 ) % 3]] ), ToDouble( m_Points[triangle.index[( i + 2 ) % 3]] ), ToDouble( point ) ) < 0.0 ) {
+            if( m_Stream && !IsHullEdge( current, i ) ) {
+                current = FindTriangle( point, &i );
+                
+                if( i < 0 )
+                    break;
+            }
+            
+            // Flips keep the segments, the cavity would have to stop at hull segments
+            if( !m_Constraint.empty() ) {
+                InsertOutside( index, current, i );
+                return;
+            }
+            
+            // The cavity then starts from the outer face
+            FindHullEdge( ToDouble( point ), current, i );
+            current = NO_NEIGHBOR;
+            break;
+        }
+    }
+    
+    // A point coinciding with an existing vertex would only add degenerate triangles
+    for( i = 0; i < 3 && current != NO_NEIGHBOR; ++i ) {
+        if( m_Points[m_Triangles[current].index[i]] == point )
+            return;
+    }
+    
+    // A point on a segment splits it in two, the cavity may then cross the segment
+    segment1 = segment2 = NO_NEIGHBOR;
+    
+    for( i = 0; i < 3 && !m_Constraint.empty(); ++i ) {
+        Index index1 = m_Triangles[current].index[( i + 1 ) % 3];
+        Index index2 = m_Triangles[current].index[( i + 2 ) % 3];
+        
+        if( IsConstraint( index1, index2 ) &&
+            Predicate::Orientation( ToDouble( m_Points[index1] ), ToDouble( m_Points[index2] ), ToDouble( point ) ) == 0.0 ) {
+            m_Constraint.erase( EdgeData( index1, index2 ) );
+            segment1 = index1;
+            segment2 = index2;
+            break;
+        }
+    }
+    
+    FindCavity( point, current );
+    m_HullEdge.clear();
+    
+    // Retriangulate in place, each boundary edge gets a triangle. The vertex links lead
+    // from an edge to the next one, the boundary is open at the hull.
+    m_NewTriangle.clear();
+    
+    for( auto edge : m_CavityBoundary ) {
+        m_VertexLink[edge.index2] = NO_NEIGHBOR;
+    }
+    
+    for( k = 0, count = 0; k < m_CavityBoundary.size(); ++k ) {
+        const CavityEdgeData& edge = m_CavityBoundary[k];
+        
+        // A point on a hull edge splits it instead of forming a flat triangle with it
+        if( edge.outer == NO_NEIGHBOR &&
+            Predicate::Orientation( ToDouble( m_Points[edge.index1] ), ToDouble( m_Points[edge.index2] ), ToDouble( point ) ) == 0.0 )
+            continue;
+        
+        if( count < m_Cavity.size() ) {
+            tri = m_Cavity[count];
+            TriangleData& triangle = m_Triangles[tri];
+            triangle.index[0] = edge.index1;
+            triangle.index[1] = edge.index2;
+            triangle.index[2] = index;
+            triangle.neighbor[0] = triangle.neighbor[1] = NO_NEIGHBOR;
+        } else {
+            tri = AddTriangle( edge.index1, edge.index2, index );
+        }
+        
+        ++count;
+        m_Triangles[tri].neighbor[2] = edge.outer;
+        
+        if( edge.outer != NO_NEIGHBOR ) {
+            TriangleData& outer = m_Triangles[edge.outer];
+            
+            for( j = 0; j < 3; ++j ) {
+                if( outer.index[j] != edge.index1 && outer.index[j] != edge.index2 ) {
+                    outer.neighbor[j] = tri;
+                    break;
+                }
+            }
+        }
+        
+        m_VertexLink[edge.index1] = tri;
+        m_NewTriangle.push_back( tri );
+    }
+    
+    for( auto tri : m_NewTriangle ) {
+        next = m_VertexLink[m_Triangles[tri].index[1]];
+        m_Triangles[tri].neighbor[0] = next;
+        
+        if( next != NO_NEIGHBOR ) {
+            m_Triangles[next].neighbor[1] = tri;
+        } else {
+            m_VertexLink[m_Triangles[tri].index[1]] = tri;
+        }
+    }
+    
+    for( k = count; k < m_Cavity.size(); ++k ) {
+        FreeTriangle( m_Cavity[k] );
+    }
+    
+    m_LastTriangle = m_NewTriangle.back();
+    m_VertexLink[index] = m_LastTriangle;
+    DELAUNAY_STATS_COUNT( triangleDestroyed, m_Cavity.size() );
+    DELAUNAY_STATS_COUNT( triangleCreated, m_NewTriangle.size() );
+    
+    if( segment1 != NO_NEIGHBOR ) {
+        m_Constraint.insert( EdgeData( segment1, index ) );
+        m_Constraint.insert( EdgeData( index, segment2 ) );
+    }
+}
+
+// Collects the hull edges a point outside of the hull sees into m_HullEdge, going
+// forward along the hull. triangle, side is one of them.
+template< typename Scalar, typename Index, typename Predicate >
+void Delaunay< Scalar, Index, Predicate >::FindHullEdge( const Eigen::Vector2d& point, Index triangle, int side )
+{
+    Index current;
+    int i, j;
+    
+    // Go back along the hull to the first visible edge
+    for( ;; ) {
+        Index vertex = m_Triangles[triangle].index[( side + 1 ) % 3];
+        
+        current = triangle;
+        i = ( side + 1 ) % 3;
+        
+        while( m_Triangles[current].neighbor[( i + 1 ) % 3] != NO_NEIGHBOR ) {
+            current = m_Triangles[current].neighbor[( i + 1 ) % 3];
+            
+            for( i = 0; m_Triangles[current].index[i] != vertex; ++i );
+        }
+        
+        const TriangleData& hull = m_Triangles[current];
+        j = ( i + 1 ) % 3;
+        
+        if( current == triangle && j == side )
+            break;
+        
+        if( Predicate::Orientation( ToDouble( m_Points[hull.index[( j + 1 ) % 3]] ), ToDouble( m_Points[hull.index[( j + 2 ) % 3]] ), point ) >= 0.0 )
+            break;
+        
+        triangle = current;
+        side = j;
+    }
+    
+    m_HullEdge.clear();
+    
+    for( ;; ) {
+        Index vertex = m_Triangles[triangle].index[( side + 2 ) % 3];
+        
+        m_HullEdge.push_back( std::make_pair( triangle, side ) );
+        
+        // Turn around the end of the edge to the next hull edge
+        current = triangle;
+        for( i = 0; m_Triangles[current].index[i] != vertex; ++i );
+        
+        while( m_Triangles[current].neighbor[( i + 2 ) % 3] != NO_NEIGHBOR ) {
+            current = m_Triangles[current].neighbor[( i + 2 ) % 3];
+            
+            for( i = 0; m_Triangles[current].index[i] != vertex; ++i );
+        }
+        
+        const TriangleData& next = m_Triangles[current];
+        j = ( i + 2 ) % 3;
+        
+        if( Predicate::Orientation( ToDouble( m_Points[next.index[( j + 1 ) % 3]] ), ToDouble( m_Points[next.index[( j + 2 ) % 3]] ), point ) >= 0.0 )
+            break;
+        
+        triangle = current;
+        side = j;
+    }
+}
+
+// Connects a point outside the hull to every hull edge it sees and restores the
+// Delaunay property with edge flips. triangle, side is one of the visible edges.
+template< typename Scalar, typename Index, typename Predicate >
+void Delaunay< Scalar, Index, Predicate >::InsertOutside( Index index, Index triangle, int side )
+{
+    Index tri, previous;
+    int i;
+    
+    FindHullEdge( ToDouble( m_Points[index] ), triangle, side );
+    
+    // Add one triangle per visible edge, each sharing an edge with the previous one
+    m_NewTriangle.clear();
+    previous = NO_NEIGHBOR;
+    
+    for( auto edge : m_HullEdge ) {
+        Index index1 = m_Triangles[edge.first].index[( edge.second + 1 ) % 3];
+        Index index2 = m_Triangles[edge.first].index[( edge.second + 2 ) % 3];
+        
+        tri = AddTriangle( index2, index1, index );
+        m_Triangles[tri].neighbor[2] = edge.first;
+        m_Triangles[edge.first].neighbor[edge.second] = tri;
+        
+        if( previous != NO_NEIGHBOR ) {
+            m_Triangles[tri].neighbor[0] = previous;
+            m_Triangles[previous].neighbor[1] = tri;
+        }
+        
+        previous = tri;
+        m_NewTriangle.push_back( tri );
+    }
+    
+    m_HullEdge.clear();
+    m_LastTriangle = m_NewTriangle.back();
+    m_VertexLink[index] = m_LastTriangle;
+    DELAUNAY_STATS_COUNT( triangleCreated, m_NewTriangle.size() );
+    
+    // Lawson flips, the new vertex stays at index 2 before and index 0 after a flip
+    while( !m_NewTriangle.empty() ) {
+        tri = m_NewTriangle.back();
+        m_NewTriangle.pop_back();
+        
+        for( i = 0; m_Triangles[tri].index[i] != index; ++i );
+        
+        if( FlipEdge( tri, i ) ) {
+            m_NewTriangle.push_back( tri );
+            m_NewTriangle.push_back( m_Triangles[tri].neighbor[1] );
+        }
+    }
+}
+
+// Flips the edge opposite triangle.index[side] when it is not locally Delaunay and not a segment
+template< typename Scalar, typename Index, typename Predicate >
+bool Delaunay< Scalar, Index, Predicate >::FlipEdge( Index triangle, int side )
+{
+    const TriangleData& tri = m_Triangles[triangle];
+    Index other = tri.neighbor[side];
+    int r;
+    
+    if( other == NO_NEIGHBOR )
+        return false;
+    
+    const TriangleData& opposite = m_Triangles[other];
+    Index p = tri.index[side];
+    Index x = tri.index[( side + 1 ) % 3];
+    Index y = tri.index[( side + 2 ) % 3];
+    
+    if( !m_Constraint.empty() && IsConstraint( x, y ) )
+        return false;
+    
+    for( r = 0; opposite.index[r] == x || opposite.index[r] == y; ++r );
+    
+    DELAUNAY_STATS_COUNT( inCircleCount, 1 );
+    
+    if( Predicate::InCircle( ToDouble( m_Points[p] ), ToDouble( m_Points[x] ), ToDouble( m_Points[y] ), ToDouble( m_Points[opposite.index[r]] ) ) <= 0.0 )
+        return false;
+    
+    SwapEdge( triangle, side );
+    
+    return true;
+}
+
+// Replaces the edge opposite triangle.index[side] by the other diagonal of the quadrilateral.
+// Afterwards the opposite vertex is index 0 of both triangles and they share the edge opposite index 1.
+template< typename Scalar, typename Index, typename Predicate >
+void Delaunay< Scalar, Index, Predicate >::SwapEdge( Index triangle, int side )
+{
+    TriangleData& tri = m_Triangles[triangle];
+    Index other = tri.neighbor[side];
+    int r;
+    
+    TriangleData& opposite = m_Triangles[other];
+    Index p = tri.index[side];
+    Index x = tri.index[( side + 1 ) % 3];
+    Index y = tri.index[( side + 2 ) % 3];
+    
+    for( r = 0; opposite.index[r] == x || opposite.index[r] == y; ++r );
+    
+    Index q = opposite.index[r];
+    Index ta = tri.neighbor[( side + 2 ) % 3];
+    Index tb = tri.neighbor[( side + 1 ) % 3];
+    Index na = opposite.neighbor[( r + 2 ) % 3];
+    Index nb = opposite.neighbor[( r + 1 ) % 3];
+    
+    tri.index[0] = p;
+    tri.index[1] = x;
+    tri.index[2] = q;
+    tri.neighbor[0] = nb;
+    tri.neighbor[1] = other;
+    tri.neighbor[2] = ta;
+    
+    opposite.index[0] = p;
+    opposite.index[1] = q;
+    opposite.index[2] = y;
+    opposite.neighbor[0] = na;
+    opposite.neighbor[1] = tb;
+    opposite.neighbor[2] = triangle;
+    
+    ReplaceNeighbor( nb, other, triangle );
+    ReplaceNeighbor( tb, triangle, other );
+    
+    m_VertexLink[p] = m_VertexLink[x] = m_VertexLink[q] = triangle;
+    m_VertexLink[y] = other;
+    
+    DELAUNAY_STATS_COUNT( triangleDestroyed, 2 );
+    DELAUNAY_STATS_COUNT( triangleCreated, 2 );
+}
+
+// Lawson flips from the edges in m_BatchEdge until every edge they lead to is locally Delaunay
+template< typename Scalar, typename Index, typename Predicate >
+void Delaunay< Scalar, Index, Predicate >::RestoreDelaunay()
+{
+    while( !m_BatchEdge.empty() ) {
+        std::pair< Index, int > edge = m_BatchEdge.back();
+        m_BatchEdge.pop_back();
+        
+        if( FlipEdge( edge.first, edge.second ) ) {
+            Index other = m_Triangles[edge.first].neighbor[1];
+            
+            m_BatchEdge.push_back( std::make_pair( edge.first, 0 ) );
+            m_BatchEdge.push_back( std::make_pair( edge.first, 2 ) );
+            m_BatchEdge.push_back( std::make_pair( other, 0 ) );
+            m_BatchEdge.push_back( std::make_pair( other, 1 ) );
+        }
+    }
+}
+
+template< typename Scalar, typename Index, typename Predicate >
+void Delaunay< Scalar, Index, Predicate >::ReplaceNeighbor( Index triangle, Index from, Index to )
+{
+    if( triangle == NO_NEIGHBOR )
+        return;
+    
+    TriangleData& tri = m_Triangles[triangle];
+    
+    for( int i = 0; i < 3; ++i ) {
+        if( tri.neighbor[i] == from ) {
+            tri.neighbor[i] = to;
+            return;
+        }
+    }
+}
+
+template< typename Scalar, typename Index, typename Predicate >
+void Delaunay< Scalar, Index, Predicate >::Triangulation()
+{
+    m_SpareCount = NO_NEIGHBOR;
+    m_Exterior = false;
+    
+    if( m_Points.size() < 3 ) {
+        m_Triangles.clear();
+        m_TriangleAlive.clear();
+        m_TriangleMark.clear();
+        m_FreeTriangle.clear();
+        return;
+    }
+    
+    // The quad-edge references need 12 slots per point, otherwise fall back to incremental insertion
+    if( m_Engine == DIVIDE_AND_CONQUER && m_Points.size() <= ( NO_NEIGHBOR - 1 ) / 12 ) {
+        DivideAndConquer< Scalar, Index, Predicate > engine;
+        
+        {
+            DELAUNAY_STATS_PHASE( DIVIDE_AND_CONQUER );
+            engine.Triangulation( m_Points, &m_Triangles, m_ThreadCount );
+            DELAUNAY_STATS_COUNT( triangleCreated, m_Triangles.size() );
+        }
+        
+        m_TriangleAlive.assign( m_Triangles.size(), true );
+        m_TriangleMark.assign( m_Triangles.size(), 0 );
+        m_FreeTriangle.clear();
+        m_LastTriangle = m_Triangles.empty() ? NO_NEIGHBOR : 0;
+        LinkVertex();
+        RemoveMarkedVertex();
+        EnforceConstraint();
+        return;
+    }
+    
+    CreateInitTriangle();
+    
+    if( m_LastTriangle != NO_NEIGHBOR ) {
+        DELAUNAY_STATS_PHASE( INSERTION );
+        
+        // The vertices of the first triangle are already linked
+        for( Index index = 0; index < m_Points.size(); ++index ) {
+            if( m_VertexLink[index] == NO_NEIGHBOR ) {
+                InsertVertex( index );
+            }
+        }
+    }
+    
+    RemoveMarkedVertex();
+    EnforceConstraint();
+}
+
+template< typename Scalar, typename Index, typename Predicate >
+Index Delaunay< Scalar, Index, Predicate >::InsertPoint( const Point& point )
+{
+    return InsertPoints( point.data(), 1 );
+}
+
+template< typename Scalar, typename Index, typename Predicate >
+Index Delaunay< Scalar, Index, Predicate >::InsertPoints( const std::vector< Point >& points )
+{
+    return InsertPoints( points.empty() ? NULL : points.front().data(), points.size() );
+}
+
+// Inserts into the current triangulation in place, the new points get the ids
+// following the existing ones in the given order. Points outside the hull extend it.
+template< typename Scalar, typename Index, typename Predicate >
+Index Delaunay< Scalar, Index, Predicate >::InsertPoints( const Scalar *pCoordinate, Index count, Index stride )
+{
+    DELAUNAY_STATS_PHASE( INSERT_POINTS );
+    
+    // The boundary left by RemoveExterior is no hull, a point outside would fill the holes again
+    if( m_Exterior )
+        return NO_NEIGHBOR;
+    
+    Index id = m_PointIndex.size();
+    Index begin = m_Points.size();
+    Index end = begin;
+    std::vector< Index > order;
+    
+    SortPoint( pCoordinate, count, stride, HILBERT_ORDER, &order );
+    
+    // Jump to the closest of about cbrt( n ) sampled triangles before the first walk
+    if( GetTriangleCount() > 0 && !order.empty() ) {
+        const Point point( pCoordinate[order[0] * stride], pCoordinate[order[0] * stride + 1] );
+        Index sample = static_cast< Index >( std::cbrt( static_cast< double >( m_Triangles.size() ) ) ) + 1;
+        Index step = m_Triangles.size() / sample + 1;
+        Scalar distance = ( m_Points[m_Triangles[m_LastTriangle].index[0]] - point ).squaredNorm();
+        
+        for( Index tri = step / 2; tri < m_Triangles.size(); tri += step ) {
+            Scalar d = ( m_Points[m_Triangles[tri].index[0]] - point ).squaredNorm();
+            
+            if( m_TriangleAlive[tri] && d < distance ) {
+                distance = d;
+                m_LastTriangle = tri;
+            }
+        }
+    }
+    
+    MergeInsertedPoint( pCoordinate, stride, order );
+    
+    // Merged points come last as copies of the point they merged into, as in SetPoint
+    for( auto index : order ) {
+        if( id + index >= m_MergeId.size() || m_MergeId[id + index] == id + index ) {
+            m_Points.push_back( Point( pCoordinate[index * stride], pCoordinate[index * stride + 1] ) );
+            m_PointIndex.push_back( id + index );
+            ++end;
+        }
+    }
+    
+    for( auto index : order ) {
+        if( id + index < m_MergeId.size() && m_MergeId[id + index] != id + index ) {
+            m_PointIndex.push_back( id + index );
+        }
+    }
+    
+    m_PointVertex.resize( m_PointIndex.size() );
+    
+    for( Index index = begin; index < m_PointIndex.size(); ++index ) {
+        m_PointVertex[m_PointIndex[index]] = index;
+    }
+    
+    for( Index index = end; index < m_PointIndex.size(); ++index ) {
+        Point point = GetPoint( m_MergeId[m_PointIndex[index]] );
+        m_Points.push_back( point );
+    }
+    
+    // Without a triangle yet there is nothing to update
+    if( GetTriangleCount() == 0 ) {
+        Triangulation();
+        return id;
+    }
+    
+    m_VertexLink.resize( m_Points.size(), NO_NEIGHBOR );
+    
+    for( Index index = begin; index < end; ++index ) {
+        InsertVertex( index );
+    }
+    
+    return id;
+}
+
+// Coincident points share the vertex of the first of them. It goes over to another one when
+// its point is removed and leaves the mesh with the last of them.
+template< typename Scalar, typename Index, typename Predicate >
+bool Delaunay< Scalar, Index, Predicate >::RemovePoint( Index id )
+{
+    if( id >= m_PointVertex.size() )
+        return false;
+    
+    Index vertex = m_PointVertex[id];
+    Index spare, other;
+    
+    if( vertex >= m_VertexLink.size() )
+        return false;
+    
+    FindSpareVertex();
+    
+    auto first = std::lower_bound( m_SpareVertex.begin(), m_SpareVertex.end(), std::make_pair( vertex, static_cast< Index >( 0 ) ) );
+    auto best = m_SpareVertex.end();
+    
+    // A duplicate or merged point only gives up its share
+    if( m_VertexLink[vertex] == NO_NEIGHBOR ) {
+        for( best = m_SpareVertex.begin(); best != m_SpareVertex.end() && best->second != vertex; ++best );
+        
+        if( best == m_SpareVertex.end() )
+            return false;
+        
+        m_SpareVertex.erase( best );
+        m_RemovedVertex.push_back( vertex );
+        
+        return true;
+    }
+    
+    // The lowest id of the others takes the vertex over, the points merged into the removed one follow it
+    for( auto it = first; it != m_SpareVertex.end() && it->first == vertex; ++it ) {
+        if( best == m_SpareVertex.end() || m_PointIndex[it->second] < m_PointIndex[best->second] ) {
+            best = it;
+        }
+    }
+    
+    if( best != m_SpareVertex.end() ) {
+        spare = best->second;
+        other = m_PointIndex[spare];
+        
+        for( auto it = first; it != m_SpareVertex.end() && it->first == vertex; ++it ) {
+            Index merged = m_PointIndex[it->second];
+            
+            if( merged < m_MergeId.size() && m_MergeId[merged] == id ) {
+                m_MergeId[merged] = other;
+            }
+        }
+        
+        m_PointIndex[vertex] = other;
+        m_PointVertex[other] = vertex;
+        m_PointIndex[spare] = id;
+        m_PointVertex[id] = spare;
+        
+        m_SpareVertex.erase( best );
+        m_RemovedVertex.push_back( spare );
+        
+        return true;
+    }
+    
+    // Only a removal that took place is repeated on later rebuilds
+    if( !RemoveVertex( vertex ) )
+        return false;
+    
+    m_RemovedVertex.push_back( vertex );
+    
+    return true;
+}
+
+// Pairs each vertex outside of the mesh with the mesh vertex at the same place, sorted by the
+// latter. Removed vertices are left out. Built again after Triangulation or new points.
+template< typename Scalar, typename Index, typename Predicate >
+void Delaunay< Scalar, Index, Predicate >::FindSpareVertex()
+{
+    if( m_SpareCount == m_Points.size() )
+        return;
+    
+    std::vector< bool > removed( m_Points.size(), false );
+    std::vector< Index > spare;
+    Index vertex;
+    
+    auto less = [this]( Index a, Index b ) {
+        return m_Points[a].x() < m_Points[b].x() || ( m_Points[a].x() == m_Points[b].x() && m_Points[a].y() < m_Points[b].y() );
+    };
+    
+    for( auto v : m_RemovedVertex ) {
+        removed[v] = true;
+    }
+    
+    for( vertex = 0; vertex < m_Points.size(); ++vertex ) {
+        if( m_VertexLink[vertex] == NO_NEIGHBOR && !removed[vertex] ) {
+            spare.push_back( vertex );
+        }
+    }
+    
+    m_SpareVertex.clear();
+    std::sort( spare.begin(), spare.end(), less );
+    
+    for( vertex = 0; vertex < m_Points.size() && !spare.empty(); ++vertex ) {
+        if( m_VertexLink[vertex] == NO_NEIGHBOR )
+            continue;
+        
+        auto range = std::equal_range( spare.begin(), spare.end(), vertex, less );
+        
+        for( auto it = range.first; it != range.second; ++it ) {
+            m_SpareVertex.push_back( std::make_pair( vertex, *it ) );
+        }
+    }
+    
+    m_SpareCount = m_Points.size();
+}
+
+template< typename Scalar, typename Index, typename Predicate >
+Index Delaunay< Scalar, Index, Predicate >::RemovePoints( const std::vector< Index >& ids )
+{
+    DELAUNAY_STATS_PHASE( REMOVE_POINTS );
+    
+    Index count = 0;
+    
+    for( auto id : ids ) {
+        if( RemovePoint( id ) ) {
+            ++count;
+        }
+    }
+    
+    return count;
+}
+
+// Removed points stay out of every later rebuild
+template< typename Scalar, typename Index, typename Predicate >
+void Delaunay< Scalar, Index, Predicate >::RemoveMarkedVertex()
+{
+    for( auto vertex : m_RemovedVertex ) {
+        RemoveVertex( vertex );
+    }
+}
+
+// Clips Delaunay ears off the link polygon of the vertex, in the star's own triangle slots,
+// then flips the new edges until they are locally Delaunay. For a hull vertex the link is an
+// open chain and the ears left after it turns convex become the new hull.
+template< typename Scalar, typename Index, typename Predicate >
+bool Delaunay< Scalar, Index, Predicate >::RemoveVertex( Index vertex )
+{
+    if( vertex >= m_VertexLink.size() || m_VertexLink[vertex] == NO_NEIGHBOR )
+        return false;
+    
+    // Segments ending at the vertex go with it
+    for( auto edge = m_Constraint.begin(); edge != m_Constraint.end(); ) {
+        if( edge->index1 == vertex || edge->index2 == vertex ) {
+            edge = m_Constraint.erase( edge );
+        } else {
+            ++edge;
+        }
+    }
+    
+    const Eigen::Vector2d point = ToDouble( m_Points[vertex] );
+    Index start, current, next, tri, count;
+    int i;
+    bool closed = true;
+    
+    start = current = m_VertexLink[vertex];
+    for( i = 0; m_Triangles[current].index[i] != vertex; ++i );
+    
+    // Turn clockwise to the first triangle of the star
+    do {
+        next = m_Triangles[current].neighbor[( i + 2 ) % 3];
+        
+        if( next == NO_NEIGHBOR ) {
+            closed = false;
+            break;
+        }
+        
+        current = next;
+        for( i = 0; m_Triangles[current].index[i] != vertex; ++i );
+    } while( current != start );
+    
+    // Collect the star and its link counterclockwise
+    m_Cavity.clear();
+    m_Ring.clear();
+    m_RingOuter.clear();
+    start = current;
+    
+    for( ;; ) {
+        const TriangleData& triangle = m_Triangles[current];
+        
+        m_Cavity.push_back( current );
+        m_Ring.push_back( triangle.index[( i + 1 ) % 3] );
+        m_RingOuter.push_back( triangle.neighbor[i] );
+        
+        next = triangle.neighbor[( i + 1 ) % 3];
+        
+        if( next == NO_NEIGHBOR ) {
+            m_Ring.push_back( triangle.index[( i + 2 ) % 3] );
+            break;
+        }
+        
+        if( next == start )
+            break;
+        
+        current = next;
+        for( i = 0; m_Triangles[current].index[i] != vertex; ++i );
+    }
+    
+    // Until the ears are in place the link vertices refer to the triangles beyond the link
+    for( auto index : m_Ring ) {
+        m_VertexLink[index] = NO_NEIGHBOR;
+    }
+    
+    for( Index k = 0; k < m_RingOuter.size(); ++k ) {
+        if( m_RingOuter[k] != NO_NEIGHBOR ) {
+            m_VertexLink[m_Ring[k]] = m_VertexLink[m_Ring[( k + 1 ) % m_Ring.size()]] = m_RingOuter[k];
+        }
+    }
+    
+    m_NewTriangle.clear();
+    count = 0;
+    
+    for( ;; ) {
+        Index n = m_Ring.size();
+        Index k, best = NO_NEIGHBOR;
+        double power, bestPower = 0.0;
+        
+        if( closed && n == 3 ) {
+            tri = m_Cavity[count++];
+            TriangleData& triangle = m_Triangles[tri];
+            triangle.index[0] = m_Ring[0];
+            triangle.index[1] = m_Ring[1];
+            triangle.index[2] = m_Ring[2];
+            triangle.neighbor[0] = m_RingOuter[1];
+            triangle.neighbor[1] = m_RingOuter[2];
+            triangle.neighbor[2] = m_RingOuter[0];
+            
+            for( k = 0; k < 3; ++k ) {
+                LinkNeighbor( m_RingOuter[k], m_Ring[k], m_Ring[( k + 1 ) % 3], tri );
+                m_VertexLink[m_Ring[k]] = tri;
+            }
+            
+            m_NewTriangle.push_back( tri );
+            break;
+        }
+        
+        if( n < 3 )
+            break;
+        
+        // The Delaunay ear is the convex one whose circumcircle has the least power at the vertex
+        for( k = closed ? 0 : 1; k < ( closed ? n : n - 1 ); ++k ) {
+            const Eigen::Vector2d a = ToDouble( m_Points[m_Ring[( k + n - 1 ) % n]] );
+            const Eigen::Vector2d b = ToDouble( m_Points[m_Ring[k]] );
+            const Eigen::Vector2d c = ToDouble( m_Points[m_Ring[( k + 1 ) % n]] );
+            double orientation = Predicate::Orientation( a, b, c );
+            
+            if( orientation <= 0.0 )
+                continue;
+            
+            power = -Predicate::InCircle( a, b, c, point ) / orientation;
+            DELAUNAY_STATS_COUNT( inCircleCount, 1 );
+            
+            if( best == NO_NEIGHBOR || power < bestPower ) {
+                best = k;
+                bestPower = power;
+            }
+        }
+        
+        if( best == NO_NEIGHBOR )
+            break;
+        
+        // Rounding in the power can pick a wrong ear among nearly cocircular ones
+        if( !IsEmptyEar( best ) ) {
+            for( k = closed ? 0 : 1; k < ( closed ? n : n - 1 ); ++k ) {
+                if( Predicate::Orientation( ToDouble( m_Points[m_Ring[( k + n - 1 ) % n]] ), ToDouble( m_Points[m_Ring[k]] ),
+                                            ToDouble( m_Points[m_Ring[( k + 1 ) % n]] ) ) > 0.0 && IsEmptyEar( k ) ) {
+                    best = k;
+                    break;
+                }
+            }
+        }
+        
+        Index previous = ( best + n - 1 ) % n;
+        Index following = ( best + 1 ) % n;
+        
+        tri = m_Cavity[count++];
+        TriangleData& triangle = m_Triangles[tri];
+        triangle.index[0] = m_Ring[previous];
+        triangle.index[1] = m_Ring[best];
+        triangle.index[2] = m_Ring[following];
+        triangle.neighbor[0] = m_RingOuter[best];
+        triangle.neighbor[1] = NO_NEIGHBOR;
+        triangle.neighbor[2] = m_RingOuter[previous];
+        
+        LinkNeighbor( m_RingOuter[previous], m_Ring[previous], m_Ring[best], tri );
+        LinkNeighbor( m_RingOuter[best], m_Ring[best], m_Ring[following], tri );
+        m_VertexLink[m_Ring[previous]] = m_VertexLink[m_Ring[best]] = m_VertexLink[m_Ring[following]] = tri;
+        m_NewTriangle.push_back( tri );
+        
+        m_RingOuter[previous] = tri;
+        m_Ring.erase( m_Ring.begin() + best );
+        m_RingOuter.erase( m_RingOuter.begin() + best );
+    }
+    
+    // What is left of an open chain is hull now
+    if( !closed ) {
+        for( Index k = 0; k + 1 < m_Ring.size(); ++k ) {
+            LinkNeighbor( m_RingOuter[k], m_Ring[k], m_Ring[k + 1], NO_NEIGHBOR );
+        }
+    }
+    
+    for( Index k = count; k < m_Cavity.size(); ++k ) {
+        FreeTriangle( m_Cavity[k] );
+    }
+    
+    DELAUNAY_STATS_COUNT( triangleDestroyed, m_Cavity.size() );
+    DELAUNAY_STATS_COUNT( triangleCreated, count );
+    
+    m_VertexLink[vertex] = NO_NEIGHBOR;
+    
+    if( !m_NewTriangle.empty() ) {
+        m_LastTriangle = m_NewTriangle.front();
+    } else {
+        m_LastTriangle = NO_NEIGHBOR;
+        
+        for( auto outer : m_RingOuter ) {
+            if( outer != NO_NEIGHBOR ) {
+                m_LastTriangle = outer;
+            }
+        }
+    }
+    
+    // Lawson flips over every edge of the new triangles
+    m_BatchEdge.clear();
+    
+    for( auto tri : m_NewTriangle ) {
+        for( i = 0; i < 3; ++i ) {
+            m_BatchEdge.push_back( std::make_pair( tri, i ) );
+        }
+    }
+    
+    RestoreDelaunay();
+    
+    return true;
+}
+
+// True when no other link vertex lies inside the circumcircle of the ear at position k
+template< typename Scalar, typename Index, typename Predicate >
+bool Delaunay< Scalar, Index, Predicate >::IsEmptyEar( Index k ) const
+{
+    Index n = m_Ring.size();
+    const Eigen::Vector2d a = ToDouble( m_Points[m_Ring[( k + n - 1 ) % n]] );
+    const Eigen::Vector2d b = ToDouble( m_Points[m_Ring[k]] );
+    const Eigen::Vector2d c = ToDouble( m_Points[m_Ring[( k + 1 ) % n]] );
+    
+    for( Index j = 0; j < n; ++j ) {
+        if( j == k || j == ( k + 1 ) % n || j == ( k + n - 1 ) % n )
+            continue;
+        
+        DELAUNAY_STATS_COUNT( inCircleCount, 1 );
+        
+        if( Predicate::InCircle( a, b, c, ToDouble( m_Points[m_Ring[j]] ) ) > 0.0 )
+            return false;
+    }
+    
+    return true;
+}
+
+template< typename Scalar, typename Index, typename Predicate >
+void Delaunay< Scalar, Index, Predicate >::LinkNeighbor( Index triangle, Index index1, Index index2, Index to )
+{
+    if( triangle == NO_NEIGHBOR )
+        return;
+    
+    TriangleData& tri = m_Triangles[triangle];
+    
+    for( int i = 0; i < 3; ++i ) {
+        if( tri.index[i] != index1 && tri.index[i] != index2 ) {
+            tri.neighbor[i] = to;
+            return;
+        }
+    }
+}
+
+template< typename Scalar, typename Index, typename Predicate >
+bool Delaunay< Scalar, Index, Predicate >::InsertSegment( Index id1, Index id2 )
+{
+    if( m_Stream || id1 >= m_PointVertex.size() || id2 >= m_PointVertex.size() || GetTriangleCount() == 0 )
+        return false;
+    
+    Index vertex1 = m_PointVertex[id1];
+    Index vertex2 = m_PointVertex[id2];
+    
+    // Duplicates of other points are not part of the mesh
+    if( vertex1 == vertex2 || m_VertexLink[vertex1] == NO_NEIGHBOR || m_VertexLink[vertex2] == NO_NEIGHBOR )
+        return false;
+    
+    DELAUNAY_STATS_PHASE( INSERT_SEGMENT );
+    
+    return InsertConstraint( vertex1, vertex2 );
+}
+
+template< typename Scalar, typename Index, typename Predicate >
+bool Delaunay< Scalar, Index, Predicate >::InsertPolygon( const std::vector< Index >& loop )
+{
+    m_PolygonPiece.clear();
+    
+    // An open chain would turn inside and outside around, a failed segment takes the loop back out
+    for( Index k = 0; k < loop.size(); ++k ) {
+        if( !InsertSegment( loop[k], loop[( k + 1 ) % loop.size()] ) ) {
+            m_ConstraintPiece.swap( m_PolygonPiece );
+            DropConstraintPiece();
+            return false;
+        }
+        
+        m_PolygonPiece.insert( m_PolygonPiece.end(), m_ConstraintPiece.begin(), m_ConstraintPiece.end() );
+    }
+    
+    return true;
+}
+
+template< typename Scalar, typename Index, typename Predicate >
+void Delaunay< Scalar, Index, Predicate >::RemoveExterior()
+{
+    std::vector< bool > inside;
+    Index i;
+    int j;
+    
+    if( m_Stream || GetTriangleCount() == 0 )
+        return;
+    
+    FindInterior( &inside );
+    
+    for( i = 0; i < m_Triangles.size(); ++i ) {
+        if( !m_TriangleAlive[i] )
+            continue;
+        
+        if( !inside[i] ) {
+            FreeTriangle( i );
+            DELAUNAY_STATS_COUNT( triangleDestroyed, 1 );
+            continue;
+        }
+        
+        for( j = 0; j < 3; ++j ) {
+            if( m_Triangles[i].neighbor[j] != NO_NEIGHBOR && !inside[m_Triangles[i].neighbor[j]] ) {
+                m_Triangles[i].neighbor[j] = NO_NEIGHBOR;
+            }
+        }
+    }
+    
+    m_LastTriangle = NO_NEIGHBOR;
+    m_Exterior = true;
+    
+    for( i = 0; i < m_Triangles.size() && m_LastTriangle == NO_NEIGHBOR; ++i ) {
+        if( m_TriangleAlive[i] ) {
+            m_LastTriangle = i;
+        }
+    }
+    
+    LinkVertex();
+}
+
+// Flood fill from the hull one layer at a time, each layer is one more segment away from
+// the outside. Segments that do not close a polygon are walked around within their layer.
+template< typename Scalar, typename Index, typename Predicate >
+void Delaunay< Scalar, Index, Predicate >::FindInterior( std::vector< bool > *pInside ) const
+{
+    std::vector< unsigned char > segment( m_Triangles.size(), 0 );
+    std::vector< Index > depth( m_Triangles.size(), NO_NEIGHBOR );
+    std::vector< Index > layer, next;
+    Index i, current, level;
+    int j, side;
+    
+    for( auto edge : m_Constraint ) {
+        current = FindEdge( edge.index1, edge.index2, &side );
+        
+        if( current == NO_NEIGHBOR )
+            continue;
+        
+        segment[current] |= 1 << side;
+        
+        Index other = m_Triangles[current].neighbor[side];
+        
+        if( other != NO_NEIGHBOR ) {
+            for( j = 0; m_Triangles[other].index[j] == edge.index1 || m_Triangles[other].index[j] == edge.index2; ++j );
+            segment[other] |= 1 << j;
+        }
+    }
+    
+    for( i = 0; i < m_Triangles.size(); ++i ) {
+        if( !m_TriangleAlive[i] )
+            continue;
+        
+        for( j = 0; j < 3; ++j ) {
+            if( m_Triangles[i].neighbor[j] != NO_NEIGHBOR )
+                continue;
+            
+            if( segment[i] & ( 1 << j ) ) {
+                next.push_back( i );
+            } else if( depth[i] == NO_NEIGHBOR ) {
+                depth[i] = 0;
+                layer.push_back( i );
+            }
+        }
+    }
+    
+    for( level = 0; !layer.empty() || !next.empty(); ++level ) {
+        for( Index k = 0; k < layer.size(); ++k ) {
+            current = layer[k];
+            
+            for( j = 0; j < 3; ++j ) {
+                Index other = m_Triangles[current].neighbor[j];
+                
+                if( other == NO_NEIGHBOR || depth[other] != NO_NEIGHBOR )
+                    continue;
+                
+                if( segment[current] & ( 1 << j ) ) {
+                    next.push_back( other );
+                } else {
+                    depth[other] = level;
+                    layer.push_back( other );
+                }
+            }
+        }
+        
+        layer.clear();
+        
+        for( auto tri : next ) {
+            if( depth[tri] == NO_NEIGHBOR ) {
+                depth[tri] = level + 1;
+                layer.push_back( tri );
+            }
+        }
+        
+        next.clear();
+    }
+    
+    pInside->resize( m_Triangles.size() );
+    
+    for( i = 0; i < m_Triangles.size(); ++i ) {
+        (*pInside)[i] = m_TriangleAlive[i] && depth[i] != NO_NEIGHBOR && ( depth[i] & 1 );
+    }
+}
+
+// Triangle of the edge between two vertices, *pSide is its third vertex
+template< typename Scalar, typename Index, typename Predicate >
+Index Delaunay< Scalar, Index, Predicate >::FindEdge( Index vertex1, Index vertex2, int *pSide ) const
+{
+    return FindAround( vertex1, [this, vertex2, pSide]( Index tri, int i ) -> bool {
+        const TriangleData& triangle = m_Triangles[tri];
+        
+        if( triangle.index[( i + 1 ) % 3] == vertex2 ) {
+            *pSide = ( i + 2 ) % 3;
+            return true;
+        }
+        
+        if( triangle.index[( i + 2 ) % 3] == vertex2 ) {
+            *pSide = ( i + 1 ) % 3;
+            return true;
+        }
+        
+        return false;
+    });
+}
+
+template< typename Scalar, typename Index, typename Predicate >
+bool Delaunay< Scalar, Index, Predicate >::IsConstraint( Index vertex1, Index vertex2 ) const
+{
+    return m_Constraint.find( EdgeData( vertex1, vertex2 ) ) != m_Constraint.end();
+}
+
+// Forces the edge between two vertices into the mesh, piece by piece where the segment runs
+// through other vertices. The crossed edges are swapped away as in Sloan's algorithm, then
+// Lawson flips make the new edges locally Delaunay again.
+template< typename Scalar, typename Index, typename Predicate >
+bool Delaunay< Scalar, Index, Predicate >::InsertConstraint( Index vertex1, Index vertex2 )
+{
+    Index current, end, x, y, k;
+    int i, side = 0;
+    
+    m_ConstraintPiece.clear();
+    
+    while( vertex1 != vertex2 ) {
+        if( FindEdge( vertex1, vertex2, &side ) != NO_NEIGHBOR ) {
+            AddConstraintPiece( vertex1, vertex2 );
+            return true;
+        }
+        
+        const Eigen::Vector2d a = ToDouble( m_Points[vertex1] );
+        const Eigen::Vector2d b = ToDouble( m_Points[vertex2] );
+        
+        // The triangle around vertex1 that the segment leaves through the far edge x, y,
+        // or a vertex lying on the segment
+        end = x = y = NO_NEIGHBOR;
+        
+        current = FindAround( vertex1, [&]( Index tri, int j ) -> bool {
+            const TriangleData& triangle = m_Triangles[tri];
+            Index index1 = triangle.index[( j + 1 ) % 3];
+            Index index2 = triangle.index[( j + 2 ) % 3];
+            const Eigen::Vector2d p1 = ToDouble( m_Points[index1] );
+            const Eigen::Vector2d p2 = ToDouble( m_Points[index2] );
+            double orientation1 = Predicate::Orientation( a, b, p1 );
+            double orientation2 = Predicate::Orientation( a, b, p2 );
+            
+            if( orientation1 == 0.0 && ( p1 - a ).dot( b - a ) > 0.0 ) {
+                end = index1;
+            } else if( orientation2 == 0.0 && ( p2 - a ).dot( b - a ) > 0.0 ) {
+                end = index2;
+            } else if( orientation1 < 0.0 && orientation2 > 0.0 ) {
+                x = index1;
+                y = index2;
+            } else {
+                return false;
+            }
+            
+            return true;
+        });
+        
+        if( current == NO_NEIGHBOR ) {
+            DropConstraintPiece();
+            return false;
+        }
+        
+        // Walk along the segment collecting the crossed edges, x stays right and y left of it
+        m_Crossing.clear();
+        
+        while( end == NO_NEIGHBOR ) {
+            if( IsConstraint( x, y ) ) {
+                DropConstraintPiece();
+                return false;
+            }
+            
+            m_Crossing.push_back( std::make_pair( x, y ) );
+            
+            for( i = 0; m_Triangles[current].index[i] == x || m_Triangles[current].index[i] == y; ++i );
+            current = m_Triangles[current].neighbor[i];
+            
+            if( current == NO_NEIGHBOR ) {
+                DropConstraintPiece();
+                return false;
+            }
+            
+            for( i = 0; m_Triangles[current].index[i] == x || m_Triangles[current].index[i] == y; ++i );
+            
+            Index z = m_Triangles[current].index[i];
+            double orientation = ( z == vertex2 ) ? 0.0 : Predicate::Orientation( a, b, ToDouble( m_Points[z] ) );
+            
+            if( orientation == 0.0 ) {
+                end = z;
+            } else if( orientation > 0.0 ) {
+                y = z;
+            } else {
+                x = z;
+            }
+        }
+        
+        // Swap every crossed edge whose quadrilateral is convex, the others wait for their turn
+        const Eigen::Vector2d e = ToDouble( m_Points[end] );
+        m_SegmentEdge.clear();
+        
+        for( k = 0; k < m_Crossing.size(); ++k ) {
+            std::pair< Index, Index > edge = m_Crossing[k];
+            current = FindEdge( edge.first, edge.second, &side );
+            
+            const TriangleData& triangle = m_Triangles[current];
+            const TriangleData& other = m_Triangles[triangle.neighbor[side]];
+            Index p = triangle.index[side];
+            
+            for( i = 0; other.index[i] == edge.first || other.index[i] == edge.second; ++i );
+            
+            Index q = other.index[i];
+            const Eigen::Vector2d pp = ToDouble( m_Points[p] );
+            const Eigen::Vector2d pq = ToDouble( m_Points[q] );
+            
+            if( !( Predicate::Orientation( pp, pq, ToDouble( m_Points[triangle.index[( side + 1 ) % 3]] ) ) < 0.0 &&
+                   Predicate::Orientation( pp, pq, ToDouble( m_Points[triangle.index[( side + 2 ) % 3]] ) ) > 0.0 ) ) {
+                m_Crossing.push_back( edge );
+                continue;
+            }
+            
+            SwapEdge( current, side );
+            
+            double orientationP = Predicate::Orientation( a, e, pp );
+            double orientationQ = Predicate::Orientation( a, e, pq );
+            
+            if( ( orientationP < 0.0 && orientationQ > 0.0 ) || ( orientationP > 0.0 && orientationQ < 0.0 ) ) {
+                m_Crossing.push_back( std::make_pair( p, q ) );
+            } else {
+                m_SegmentEdge.push_back( std::make_pair( p, q ) );
+            }
+        }
+        
+        AddConstraintPiece( vertex1, end );
+        
+        // The triangles next to the new edges are where the mesh may have stopped being Delaunay
+        m_BatchEdge.clear();
+        
+        for( auto edge : m_SegmentEdge ) {
+            current = FindEdge( edge.first, edge.second, &side );
+            
+            if( current == NO_NEIGHBOR )
+                continue;
+            
+            for( i = 0; i < 3; ++i ) {
+                m_BatchEdge.push_back( std::make_pair( current, i ) );
+                
+                if( m_Triangles[current].neighbor[side] != NO_NEIGHBOR ) {
+                    m_BatchEdge.push_back( std::make_pair( m_Triangles[current].neighbor[side], i ) );
+                }
+            }
+        }
+        
+        RestoreDelaunay();
+        vertex1 = end;
+    }
+    
+    return true;
+}
+
+// Pieces that were constraints before are left out, a failed segment takes back only its own
+template< typename Scalar, typename Index, typename Predicate >
+void Delaunay< Scalar, Index, Predicate >::AddConstraintPiece( Index vertex1, Index vertex2 )
+{
+    if( m_Constraint.insert( EdgeData( vertex1, vertex2 ) ).second ) {
+        m_ConstraintPiece.push_back( EdgeData( vertex1, vertex2 ) );
+    }
+}
+
+// Takes back the pieces of a segment that could not be inserted as a whole. Their edges stay
+// in the mesh without the constraint, so the flips it held back are done now.
+template< typename Scalar, typename Index, typename Predicate >
+void Delaunay< Scalar, Index, Predicate >::DropConstraintPiece()
+{
+    Index current;
+    int side = 0;
+    
+    m_BatchEdge.clear();
+    
+    for( auto edge : m_ConstraintPiece ) {
+        m_Constraint.erase( edge );
+    }
+    
+    for( auto edge : m_ConstraintPiece ) {
+        current = FindEdge( edge.index1, edge.index2, &side );
+        
+        if( current != NO_NEIGHBOR ) {
+            m_BatchEdge.push_back( std::make_pair( current, side ) );
+        }
+    }
+    
+    m_ConstraintPiece.clear();
+    RestoreDelaunay();
+}
+
+// Forces the stored segments into a rebuilt mesh
+template< typename Scalar, typename Index, typename Predicate >
+void Delaunay< Scalar, Index, Predicate >::EnforceConstraint()
+{
+    std::set< EdgeData > constraint;
+    
+    constraint.swap( m_Constraint );
+    
+    for( auto edge : constraint ) {
+        if( m_VertexLink[edge.index1] != NO_NEIGHBOR && m_VertexLink[edge.index2] != NO_NEIGHBOR ) {
+            InsertConstraint( edge.index1, edge.index2 );
+        }
+    }
+}
+
+template< typename Scalar, typename Index, typename Predicate >
+typename Delaunay< Scalar, Index, Predicate >::Point Delaunay< Scalar, Index, Predicate >::GetCircumcenter( Index triangle )
+{
+    const TriangleData& tri = m_Triangles[triangle];
+    
+    return Predicates::Circumcenter( ToDouble( m_Points[tri.index[0]] ), ToDouble( m_Points[tri.index[1]] ),
+                                     ToDouble( m_Points[tri.index[2]] ) ).template cast< Scalar >();
+}
+
+template< typename Scalar, typename Index, typename Predicate >
+Index Delaunay< Scalar, Index, Predicate >::Refine( double minAngle, double maxArea, Index maxPoints )
+{
+    struct BadTriangle
+    {
+        double  quality;
+        Index   triangle;
+        Index   index[3];
+        
+        bool operator<( const BadTriangle& other ) const
+        {
+            return quality > other.quality;
+        }
+    };
+    
+    std::priority_queue< BadTriangle > bad;
+    std::vector< EdgeData > encroached;
+    std::set< EdgeData > fixed;
+    const double bound = std::sin( minAngle * M_PI / 180.0 );
+    Index first, count, tri, vertex;
+    int i;
+    
+    if( m_Stream || GetTriangleCount() == 0 )
+        return 0;
+    
+    DELAUNAY_STATS_PHASE( REFINE );
+    
+    // The quality is sin of the smallest angle, the shortest edge over the circumdiameter
+    auto check = [&]( Index triangle ) {
+        const TriangleData& t = m_Triangles[triangle];
+        const Eigen::Vector2d a = ToDouble( m_Points[t.index[0]] );
+        const Eigen::Vector2d b = ToDouble( m_Points[t.index[1]] );
+        const Eigen::Vector2d c = ToDouble( m_Points[t.index[2]] );
+        double ab = ( b - a ).norm(), bc = ( c - b ).norm(), ca = ( a - c ).norm();
+        double area = 0.5 * Predicate::Orientation( a, b, c );
+        
+        if( area <= 0.0 )
+            return;
+        
+        BadTriangle entry;
+        entry.quality = 2.0 * area * std::min( ab, std::min( bc, ca ) ) / ( ab * bc * ca );
+        
+        if( entry.quality >= bound && !( maxArea > 0.0 && area > maxArea ) )
+            return;
+        
+        entry.triangle = triangle;
+        entry.index[0] = t.index[0];
+        entry.index[1] = t.index[1];
+        entry.index[2] = t.index[2];
+        bad.push( entry );
+    };
+    
+    // The triangles around a new vertex are new, and it may encroach on the segments across from it
+    auto update = [&]( Index vertex ) {
+        const Point& point = m_Points[vertex];
+        
+        FindAround( vertex, [&]( Index triangle, int j ) -> bool {
+            Index index1 = m_Triangles[triangle].index[( j + 1 ) % 3];
+            Index index2 = m_Triangles[triangle].index[( j + 2 ) % 3];
+            
+            check( triangle );
+            
+            if( IsConstraint( index1, index2 ) && ( m_Points[index1] - point ).dot( m_Points[index2] - point ) < 0 &&
+                fixed.count( EdgeData( index1, index2 ) ) == 0 ) {
+                encroached.push_back( EdgeData( index1, index2 ) );
+            }
+            
+            return false;
+        });
+    };
+    
+    for( tri = 0; tri < m_Triangles.size(); ++tri ) {
+        if( !m_TriangleAlive[tri] )
+            continue;
+        
+        for( i = 0; i < 3; ++i ) {
+            if( m_Triangles[tri].neighbor[i] == NO_NEIGHBOR ) {
+                m_Constraint.insert( EdgeData( m_Triangles[tri].index[( i + 1 ) % 3], m_Triangles[tri].index[( i + 2 ) % 3] ) );
+            }
+        }
+        
+        check( tri );
+    }
+    
+    for( auto edge : m_Constraint ) {
+        if( IsEncroached( edge.index1, edge.index2 ) ) {
+            encroached.push_back( edge );
+        }
+    }
+    
+    first = m_Points.size();
+    count = 0;
+    
+    while( count < maxPoints ) {
+        // Segments go first, a circumcenter is only inserted while none is encroached.
+        // Those split before are no segments any more.
+        if( !encroached.empty() ) {
+            EdgeData edge = encroached.back();
+            encroached.pop_back();
+            
+            if( IsConstraint( edge.index1, edge.index2 ) ) {
+                vertex = SplitSegment( edge.index1, edge.index2, first );
+                
+                // Too short to split in floating point, it stays as it is
+                if( vertex == NO_NEIGHBOR ) {
+                    fixed.insert( edge );
+                    continue;
+                }
+                
+                update( vertex );
+                ++count;
+            }
+            
+            continue;
+        }
+        
+        if( bad.empty() )
+            break;
+        
+        BadTriangle entry = bad.top();
+        bad.pop();
+        
+        // The queue keeps triangles that have been replaced since
+        tri = entry.triangle;
+        
+        if( !m_TriangleAlive[tri] )
+            continue;
+        
+        for( i = 0; i < 3; ++i ) {
+            const Index *pIndex = m_Triangles[tri].index;
+            
+            if( pIndex[0] != entry.index[i] && pIndex[1] != entry.index[i] && pIndex[2] != entry.index[i] )
+                break;
+        }
+        
+        if( i < 3 )
+            continue;
+        
+        const Point center = GetCircumcenter( tri );
+        EdgeData segment;
+        Index current = WalkToward( tri, center, &segment );
+        
+        // A center that cannot be seen from its triangle lies behind an encroached segment
+        if( current == NO_NEIGHBOR ) {
+            if( fixed.count( segment ) == 0 && IsConstraint( segment.index1, segment.index2 ) ) {
+                encroached.push_back( segment );
+                bad.push( entry );
+            }
+            
+            continue;
+        }
+        
+        // A center encroaching on segments of its cavity boundary splits those instead
+        FindCavity( center, current );
+        
+        bool blocked = false;
+        
+        for( auto edge : m_CavityBoundary ) {
+            if( IsConstraint( edge.index1, edge.index2 ) && ( m_Points[edge.index1] - center ).dot( m_Points[edge.index2] - center ) < 0 ) {
+                blocked = true;
+                
+                if( fixed.count( EdgeData( edge.index1, edge.index2 ) ) == 0 ) {
+                    encroached.push_back( EdgeData( edge.index1, edge.index2 ) );
+                }
+            }
+        }
+        
+        if( blocked ) {
+            if( !encroached.empty() ) {
+                bad.push( entry );
+            }
+            
+            continue;
+        }
+        
+        vertex = AddVertex( center );
+        m_LastTriangle = current;
+        InsertVertex( vertex );
+        
+        if( m_VertexLink[vertex] == NO_NEIGHBOR ) {
+            RemoveLastVertex();
+            continue;
+        }
+        
+        update( vertex );
+        ++count;
+    }
+    
+    return count;
+}
+
+// Appends a point with the next id, not yet part of the mesh
+template< typename Scalar, typename Index, typename Predicate >
+Index Delaunay< Scalar, Index, Predicate >::AddVertex( const Point& point )
+{
+    Index vertex = m_Points.size();
+    
+    m_Points.push_back( point );
+    m_PointVertex.push_back( vertex );
+    m_PointIndex.push_back( m_PointVertex.size() - 1 );
+    m_VertexLink.push_back( NO_NEIGHBOR );
+    
+    return vertex;
+}
+
+// Takes back the last AddVertex when the point could not be inserted
+template< typename Scalar, typename Index, typename Predicate >
+void Delaunay< Scalar, Index, Predicate >::RemoveLastVertex()
+{
+    m_Points.pop_back();
+    m_PointVertex.pop_back();
+    m_PointIndex.pop_back();
+    m_VertexLink.pop_back();
+}
+
+// Walks from triangle to the one containing point without crossing a segment or the boundary,
+// NO_NEIGHBOR with *pSegment when one is in the way
+template< typename Scalar, typename Index, typename Predicate >
+Index Delaunay< Scalar, Index, Predicate >::WalkToward( Index triangle, const Point& point, EdgeData *pSegment ) const
+{
+    const Eigen::Vector2d p = ToDouble( point );
+    Index current = triangle;
+    int i;
+    
+    for( ;; ) {
+        const TriangleData& tri = m_Triangles[current];
+        
+        for( i = 0; i < 3; ++i ) {
+            if( Predicate::Orientation( ToDouble( m_Points[tri.index[( i + 1 ) % 3]] ), ToDouble( m_Points[tri.index[( i + 2 ) % 3]] ), p ) < 0.0 )
+                break;
+        }
+        
+        if( i == 3 )
+            return current;
+        
+        if( tri.neighbor[i] == NO_NEIGHBOR || IsConstraint( tri.index[( i + 1 ) % 3], tri.index[( i + 2 ) % 3] ) ) {
+            *pSegment = EdgeData( tri.index[( i + 1 ) % 3], tri.index[( i + 2 ) % 3] );
+            return NO_NEIGHBOR;
+        }
+        
+        current = tri.neighbor[i];
+    }
+}
+
+// A segment is encroached when the apex of a triangle next to it lies inside its diametral circle
+template< typename Scalar, typename Index, typename Predicate >
+bool Delaunay< Scalar, Index, Predicate >::IsEncroached( Index vertex1, Index vertex2 ) const
+{
+    int side;
+    Index tri = FindEdge( vertex1, vertex2, &side );
+    
+    if( tri == NO_NEIGHBOR )
+        return false;
+    
+    for( int k = 0; k < 2 && tri != NO_NEIGHBOR; ++k ) {
+        const TriangleData& triangle = m_Triangles[tri];
+        
+        for( side = 0; triangle.index[side] == vertex1 || triangle.index[side] == vertex2; ++side );
+        
+        const Point& apex = m_Points[triangle.index[side]];
+        
+        if( ( m_Points[vertex1] - apex ).dot( m_Points[vertex2] - apex ) < 0 )
+            return true;
+        
+        tri = triangle.neighbor[side];
+    }
+    
+    return false;
+}
+
+// True when vertex is an input vertex where another segment than the one to other ends
+template< typename Scalar, typename Index, typename Predicate >
+bool Delaunay< Scalar, Index, Predicate >::IsCorner( Index vertex, Index other, Index first ) const
+{
+    if( vertex >= first )
+        return false;
+    
+    return FindAround( vertex, [this, vertex, other]( Index triangle, int j ) -> bool {
+        Index index1 = m_Triangles[triangle].index[( j + 1 ) % 3];
+        Index index2 = m_Triangles[triangle].index[( j + 2 ) % 3];
+        
+        return ( index1 != other && IsConstraint( vertex, index1 ) ) || ( index2 != other && IsConstraint( vertex, index2 ) );
+    }) != NO_NEIGHBOR;
+}
+
+// Splits a segment in the middle, or next to a corner at a power of two distance from it so
+// that the splits of segments meeting at a small angle fall on common circles and stop.
+// Vertices from first on are Steiner points.
+template< typename Scalar, typename Index, typename Predicate >
+Index Delaunay< Scalar, Index, Predicate >::SplitSegment( Index vertex1, Index vertex2, Index first )
+{
+    const Eigen::Vector2d a = ToDouble( m_Points[vertex1] );
+    const Eigen::Vector2d b = ToDouble( m_Points[vertex2] );
+    bool corner1 = IsCorner( vertex1, vertex2, first );
+    bool corner2 = IsCorner( vertex2, vertex1, first );
+    double t = 0.5;
+    int side = 0;
+    
+    if( corner1 != corner2 ) {
+        double length = ( b - a ).norm();
+        double shell = std::pow( 2.0, std::floor( std::log2( length / 2.0 ) + 0.5 ) );
+        
+        t = corner1 ? shell / length : 1.0 - shell / length;
+    }
+    
+    Index vertex = AddVertex( ( a + t * ( b - a ) ).template cast< Scalar >() );
+    Index tri = FindEdge( vertex1, vertex2, &side );
+    
+    m_Constraint.erase( EdgeData( vertex1, vertex2 ) );
+    
+    if( m_Triangles[tri].neighbor[side] == NO_NEIGHBOR ) {
+        // On the boundary the triangle is split in two directly, a point rounded to either
+        // side of the segment would otherwise leave a sliver or join other boundary edges
+        Index other = AllocateTriangle();
+        TriangleData& triangle = m_Triangles[tri];
+        Index c = triangle.index[side];
+        Index x = triangle.index[( side + 1 ) % 3];
+        Index y = triangle.index[( side + 2 ) % 3];
+        Index nx = triangle.neighbor[( side + 1 ) % 3];
+        Index ny = triangle.neighbor[( side + 2 ) % 3];
+        
+        triangle.index[0] = c;
+        triangle.index[1] = x;
+        triangle.index[2] = vertex;
+        triangle.neighbor[0] = NO_NEIGHBOR;
+        triangle.neighbor[1] = other;
+        triangle.neighbor[2] = ny;
+        
+        TriangleData& split = m_Triangles[other];
+        split.index[0] = c;
+        split.index[1] = vertex;
+        split.index[2] = y;
+        split.neighbor[0] = NO_NEIGHBOR;
+        split.neighbor[1] = nx;
+        split.neighbor[2] = tri;
+        
+        ReplaceNeighbor( nx, tri, other );
+        m_VertexLink[c] = m_VertexLink[x] = m_VertexLink[vertex] = tri;
+        m_VertexLink[y] = other;
+        m_LastTriangle = tri;
+        DELAUNAY_STATS_COUNT( triangleDestroyed, 1 );
+        DELAUNAY_STATS_COUNT( triangleCreated, 2 );
+        
+        m_BatchEdge.clear();
+        m_BatchEdge.push_back( std::make_pair( tri, 2 ) );
+        m_BatchEdge.push_back( std::make_pair( other, 1 ) );
+        RestoreDelaunay();
+    } else {
+        m_LastTriangle = tri;
+        InsertVertex( vertex );
+        
+        if( m_VertexLink[vertex] == NO_NEIGHBOR ) {
+            m_Constraint.insert( EdgeData( vertex1, vertex2 ) );
+            RemoveLastVertex();
+            return NO_NEIGHBOR;
+        }
+    }
+    
+    InsertConstraint( vertex1, vertex );
+    InsertConstraint( vertex, vertex2 );
+    
+    return vertex;
+}
+
+template< typename Scalar, typename Index, typename Predicate >
+void Delaunay< Scalar, Index, Predicate >::BeginStream( const Point& min, const Point& max )
+{
+    m_Points.clear();
+    m_PointIndex.clear();
+    m_PointVertex.clear();
+    m_RemovedVertex.clear();
+    m_MergeId.clear();
+    m_Constraint.clear();
+    m_FinalTriangle.clear();
+    
+    m_Triangles.clear();
+    m_TriangleAlive.clear();
+    m_TriangleMark.clear();
+    m_FreeTriangle.clear();
+    m_Mark = 0;
+    
+    m_VertexLink.clear();
+    m_FrontEdge.clear();
+    m_LastTriangle = NO_NEIGHBOR;
+    
+    m_Stream = true;
+    m_StreamCount = 0;
+    m_StreamMin = min;
+    m_StreamMax = max;
+}
+
+template< typename Scalar, typename Index, typename Predicate >
+void Delaunay< Scalar, Index, Predicate >::InsertStream( const Scalar *pCoordinate, Index count, Index stride )
+{
+    Index begin = m_Points.size();
+    Scalar sweep = pCoordinate[0];
+    std::vector< Index > order;
+    
+    m_FinalTriangle.clear();
+    
+    if( count == 0 )
+        return;
+    
+    SortPoint( pCoordinate, count, stride, HILBERT_ORDER, &order );
+    
+    for( auto index : order ) {
+        m_Points.push_back( Point( pCoordinate[index * stride], pCoordinate[index * stride + 1] ) );
+        m_PointIndex.push_back( m_StreamCount + index );
+        sweep = std::max( sweep, m_Points.back().x() );
+    }
+    
+    m_StreamCount += count;
+    m_VertexLink.resize( m_Points.size(), NO_NEIGHBOR );
+    
+    // The points are only kept until three of them span the first triangle
+    if( m_LastTriangle == NO_NEIGHBOR ) {
+        CreateInitTriangle();
+        
+        if( m_LastTriangle == NO_NEIGHBOR )
+            return;
+        
+        begin = 0;
+    }
+    
+    for( Index index = begin; index < m_Points.size(); ++index ) {
+        if( m_VertexLink[index] == NO_NEIGHBOR ) {
+            InsertVertex( index );
+        }
+    }
+    
+    FinalizeStream( static_cast< double >( sweep ), false );
+    CompactStream();
+}
+
+template< typename Scalar, typename Index, typename Predicate >
+void Delaunay< Scalar, Index, Predicate >::FinishStream()
+{
+    m_FinalTriangle.clear();
+    FinalizeStream( 0.0, true );
+    
+    m_Triangles.clear();
+    m_TriangleAlive.clear();
+    m_TriangleMark.clear();
+    m_FreeTriangle.clear();
+    m_Points.clear();
+    m_PointIndex.clear();
+    m_VertexLink.clear();
+    m_FrontEdge.clear();
+    m_LastTriangle = NO_NEIGHBOR;
+    m_Stream = false;
+}
+
+// No later point can fall into a circumcircle that ends before the sweep line, so those
+// triangles are final. They are cut out of the mesh and the edges they leave to their
+// neighbours go to m_FrontEdge, which tells them from hull edges. A hull edge that a later
+// point may still see keeps the triangles around its ends, the hull is walked through them.
+template< typename Scalar, typename Index, typename Predicate >
+void Delaunay< Scalar, Index, Predicate >::FinalizeStream( double sweep, bool all )
+{
+    std::vector< bool > keep( m_Points.size(), false );
+    Index tri;
+    int i;
+    
+    for( tri = 0; tri < m_Triangles.size() && !all; ++tri ) {
+        if( !m_TriangleAlive[tri] )
+            continue;
+        
+        for( i = 0; i < 3; ++i ) {
+            if( IsHullEdge( tri, i ) && !IsHullFinal( tri, i, sweep ) ) {
+                keep[m_Triangles[tri].index[( i + 1 ) % 3]] = true;
+                keep[m_Triangles[tri].index[( i + 2 ) % 3]] = true;
+            }
+        }
+    }
+    
+    for( tri = 0; tri < m_Triangles.size(); ++tri ) {
+        if( !m_TriangleAlive[tri] )
+            continue;
+        
+        const TriangleData& triangle = m_Triangles[tri];
+        
+        if( !all ) {
+            if( keep[triangle.index[0]] || keep[triangle.index[1]] || keep[triangle.index[2]] )
+                continue;
+            
+            const Eigen::Vector2d a = ToDouble( m_Points[triangle.index[0]] );
+            const Eigen::Vector2d center = Predicates::Circumcenter( a, ToDouble( m_Points[triangle.index[1]] ), ToDouble( m_Points[triangle.index[2]] ) );
+            double radius = ( center - a ).norm();
+            
+            // The margin covers the rounding of the center and radius, a nearly flat triangle stays
+            if( !( center.x() + radius + 1e-9 * ( std::fabs( center.x() ) + radius ) < sweep ) )
+                continue;
+        }
+        
+        for( i = 0; i < 3; ++i ) {
+            EdgeData edge( triangle.index[( i + 1 ) % 3], triangle.index[( i + 2 ) % 3] );
+            
+            m_FinalTriangle.push_back( m_PointIndex[triangle.index[i]] );
+            
+            if( triangle.neighbor[i] != NO_NEIGHBOR ) {
+                ReplaceNeighbor( triangle.neighbor[i], tri, NO_NEIGHBOR );
+                m_FrontEdge.insert( edge );
+            } else {
+                m_FrontEdge.erase( edge );
+            }
+        }
+        
+        FreeTriangle( tri );
+        DELAUNAY_STATS_COUNT( triangleDestroyed, 1 );
+    }
+}
+
+// An edge without a neighbour that is not the edge of a finalized triangle
+template< typename Scalar, typename Index, typename Predicate >
+bool Delaunay< Scalar, Index, Predicate >::IsHullEdge( Index triangle, int side ) const
+{
+    const TriangleData& tri = m_Triangles[triangle];
+    
+    if( tri.neighbor[side] != NO_NEIGHBOR )
+        return false;
+    
+    return m_FrontEdge.empty() || m_FrontEdge.find( EdgeData( tri.index[( side + 1 ) % 3], tri.index[( side + 2 ) % 3] ) ) == m_FrontEdge.end();
+}
+
+// The infinite triangle beyond a hull edge is in conflict with the points beyond its line.
+// Later points lie in the bounds from the sweep line on, none of them is when no corner is.
+template< typename Scalar, typename Index, typename Predicate >
+bool Delaunay< Scalar, Index, Predicate >::IsHullFinal( Index triangle, int side, double sweep ) const
+{
+    const TriangleData& tri = m_Triangles[triangle];
+    const Eigen::Vector2d a = ToDouble( m_Points[tri.index[( side + 1 ) % 3]] );
+    const Eigen::Vector2d b = ToDouble( m_Points[tri.index[( side + 2 ) % 3]] );
+    const double x_min = sweep, x_max = m_StreamMax.x(), y_min = m_StreamMin.y(), y_max = m_StreamMax.y();
+    const Eigen::Vector2d corner[4] = { Eigen::Vector2d( x_min, y_min ), Eigen::Vector2d( x_max, y_min ), Eigen::Vector2d( x_max, y_max ), Eigen::Vector2d( x_min, y_max ) };
+    
+    for( int i = 0; i < 4; ++i ) {
+        if( Predicate::Orientation( a, b, corner[i] ) < 0.0 )
+            return false;
+    }
+    
+    return true;
+}
+
+// Drops the finalized triangles and the points no live triangle uses any more
+template< typename Scalar, typename Index, typename Predicate >
+void Delaunay< Scalar, Index, Predicate >::CompactStream()
+{
+    std::vector< Index > TriangleIndex( m_Triangles.size(), NO_NEIGHBOR );
+    std::vector< Index > PointIndex( m_Points.size(), NO_NEIGHBOR );
+    Index i, count;
+    int j;
+    
+    for( i = 0, count = 0; i < m_Triangles.size(); ++i ) {
+        if( !m_TriangleAlive[i] )
+            continue;
+        
+        TriangleIndex[i] = count++;
+        
+        for( j = 0; j < 3; ++j ) {
+            PointIndex[m_Triangles[i].index[j]] = 0;
+        }
+    }
+    
+    for( i = 0, count = 0; i < m_Points.size(); ++i ) {
+        if( PointIndex[i] == NO_NEIGHBOR )
+            continue;
+        
+        PointIndex[i] = count;
+        m_Points[count] = m_Points[i];
+        m_PointIndex[count] = m_PointIndex[i];
+        ++count;
+    }
+    
+    m_Points.resize( count );
+    m_PointIndex.resize( count );
+    
+    std::set< EdgeData > front;
+    
+    for( auto edge : m_FrontEdge ) {
+        front.insert( EdgeData( PointIndex[edge.index1], PointIndex[edge.index2] ) );
+    }
+    
+    m_FrontEdge.swap( front );
+    
+    for( i = 0, count = 0; i < m_Triangles.size(); ++i ) {
+        if( TriangleIndex[i] == NO_NEIGHBOR )
+            continue;
+        
+        TriangleData tri = m_Triangles[i];
+        
+        for( j = 0; j < 3; ++j ) {
+            tri.index[j] = PointIndex[tri.index[j]];
+            
+            if( tri.neighbor[j] != NO_NEIGHBOR ) {
+                tri.neighbor[j] = TriangleIndex[tri.neighbor[j]];
+            }
+        }
+        
+        m_Triangles[count++] = tri;
+    }
+    
+    m_LastTriangle = ( m_LastTriangle != NO_NEIGHBOR && TriangleIndex[m_LastTriangle] != NO_NEIGHBOR ) ? TriangleIndex[m_LastTriangle] : ( count > 0 ? 0 : NO_NEIGHBOR );
+    
+    m_Triangles.resize( count );
+    m_TriangleAlive.assign( count, true );
+    m_TriangleMark.assign( count, 0 );
+    m_FreeTriangle.clear();
+    m_Mark = 0;
+    
+    LinkVertex();
+}
+
+template class Delaunay< double, uint32_t, ExactPredicate >;
+template class Delaunay< double, uint64_t, ExactPredicate >;
+template class Delaunay< float, uint32_t, ExactPredicate >;
+template class Delaunay< double, uint32_t, FastPredicate >;
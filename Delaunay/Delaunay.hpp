@@ -10,53 +10,56 @@
 #include <stdio.h>
 #include <vector>
 #include <set>
+#include <algorithm>
 #include <Eigen/Core>
 #include <Eigen/Geometry>
+#include <stdint.h>
+#include "Predicates.hpp"
+#include "Statistics.hpp"
 
+inline namespace DELAUNAY_STATS_NAMESPACE {
+
+// Scalar is the coordinate type, Index the vertex and triangle index type and Predicate
+// the precision policy for the geometric tests ( ExactPredicate or FastPredicate ).
+// Instantiated for < double, uint32_t >, < double, uint64_t > and < float, uint32_t >.
+template< typename Scalar = double, typename Index = uint32_t, typename Predicate = ExactPredicate >
 class Delaunay
 {
 public:
+    typedef Eigen::Matrix< Scalar, 2, 1 > Point;
+    
+    static const Index NO_NEIGHBOR = static_cast< Index >( -1 );
+
+    enum Engine
+    {
+        BOWYER_WATSON,
+        DIVIDE_AND_CONQUER
+    };
+
+    // The order points are inserted in. Input order sorts them along the Hilbert curve too,
+    // but keeps coincident points in input order, so the first of them gets the vertex.
+    enum InsertionOrder
+    {
+        INPUT_ORDER,
+        HILBERT_ORDER,
+        BRIO_ORDER
+    };
+
     struct TriangleData
     {
-        unsigned long   index1;
-        unsigned long   index2;
-        unsigned long   index3;
-        double          radius;
-        double          bounds[4];
-        Eigen::Vector2d center;
+        Index   index[3];
+        Index   neighbor[3];
         
         TriangleData()
         {
-            index1 = index2 = index3 = 0;
-            bounds[0] = bounds[1] = bounds[2] = bounds[3] = 0.0;
-            radius = 0.0;
-            center = Eigen::Vector2d::Zero();
-        }
-
-        bool IsInside( Eigen::Vector2d point )
-        {
-            if( point.x() < bounds[0] )
-                return false;
-
-            if( point.x() > bounds[1] )
-                return false;
-
-            if( point.y() < bounds[2] )
-                return false;
-
-            if( point.y() > bounds[3] )
-                return false;
-
-            if( ( point - center ).norm() > radius )
-                return false;
-        
-            return true;
+            index[0] = index[1] = index[2] = 0;
+            neighbor[0] = neighbor[1] = neighbor[2] = NO_NEIGHBOR;
         }
     };
     
     struct EdgeData
     {
-        unsigned long index1, index2;
+        Index index1, index2;
         
         EdgeData()
         {
@@ -64,7 +67,7 @@ public:
             index2 = 0;
         };
         
-        EdgeData( unsigned long index1, unsigned long index2 )
+        EdgeData( Index index1, Index index2 )
         {
             if( index1 < index2 ) {
                 this->index1 = index1;
@@ -74,26 +77,303 @@ public:
                 this->index2 = index1;
             }
         };
+        
+        bool operator<( const EdgeData& edge ) const
+        {
+            return ( index1 < edge.index1 ) || ( index1 == edge.index1 && index2 < edge.index2 );
+        }
     };
     
 public:
-    Delaunay();
+    Delaunay( Engine engine = BOWYER_WATSON );
     ~Delaunay();
 
-    void SetPoint( std::vector< Eigen::Vector2d > *pPointList );
-    void GetResult( std::vector< Eigen::Vector2d > *pPointList, std::vector< std::vector< unsigned int > > *pIndexList );
+    void SetPoint( std::vector< Point > *pPointList, InsertionOrder order = INPUT_ORDER );
+    
+    // Non-owning view of count points, point i is ( pCoordinate[i * stride], pCoordinate[i * stride + 1] )
+    void SetPoint( const Scalar *pCoordinate, Index count, Index stride = 2, InsertionOrder order = INPUT_ORDER );
+    void SetThreadCount( unsigned int count );
+    
+    // Points closer than distance to a kept point with a lower id merge into the lowest such
+    // one when SetPoint or InsertPoints reads them, they take its position and get no triangle.
+    // Kept points are farther apart than distance. 0, the default, only skips exact duplicates.
+    void SetMergeDistance( Scalar distance ) { m_MergeDistance = distance; }
+    
+    // ( *pId )[id] is the point id merged into, id itself for every point that was kept
+    void GetMergedId( std::vector< Index > *pId ) const;
+    void GetResult( std::vector< Point > *pPointList, std::vector< std::vector< unsigned int > > *pIndexList );
+    
+    // Writes 3 * GetTriangleCount() indices of the caller's points into pIndexBuffer
+    Index GetTriangleCount() const;
+    void GetResult( Index *pIndexBuffer ) const;
+    
+    // The same number of triangle indices, neighbor[i] is opposite index[i] and NO_NEIGHBOR on the hull
+    void GetNeighbor( Index *pNeighborBuffer ) const;
+    
+    // Edges without a neighbor, the hull or after RemoveExterior the boundary. Edge k goes from
+    // point ( *pEdge )[2 * k] to ( *pEdge )[2 * k + 1] with the mesh on its left.
+    void GetBoundary( std::vector< Index > *pEdge ) const;
+    
+    Index GetPointCount() const { return m_PointIndex.size(); }
+    Point GetPoint( Index id ) const { return m_Points[m_PointVertex[id]]; }
+    
+    // Calls callback( index1, index2, index3 ) for every triangle without any buffer
+    template< typename Callback >
+    void ForEachTriangle( Callback callback ) const
+    {
+        for( Index i = 0; i < m_Triangles.size(); ++i ) {
+            if( !m_TriangleAlive[i] )
+                continue;
+            
+            const TriangleData& tri = m_Triangles[i];
+            callback( m_PointIndex[tri.index[0]], m_PointIndex[tri.index[1]], m_PointIndex[tri.index[2]] );
+        }
+    }
     
     void Triangulation();
     
+    // Save the result in the MeshFile format, optionally with the triangle adjacency
+    bool Write( const char *pFileName, bool neighbor = false ) const;
+    
+    // Voronoi diagram, the dual of the triangulation. Vertex k is the circumcenter of triangle k
+    // in GetResult order. The cell of point id lists the vertices from pCell[( *pCellOffset )[id]]
+    // up to pCell[( *pCellOffset )[id + 1] - 1] counterclockwise. The cell of a hull point is open,
+    // its first vertex goes off to infinity along ( *pRay )[2 * id] and its last along
+    // ( *pRay )[2 * id + 1], both zero for a closed cell. Points without a triangle have no cell.
+    void GetVoronoi( std::vector< Point > *pVertex, std::vector< Index > *pCellOffset, std::vector< Index > *pCell, std::vector< Point > *pRay ) const;
+    
+    // The cells clipped to the box from min to max, as closed counterclockwise polygons
+    void GetVoronoi( const Point& min, const Point& max, std::vector< Point > *pCellPoint, std::vector< Index > *pCellOffset ) const;
+    
+    // Update the current triangulation, the returned id is that of the first new point
+    Index InsertPoint( const Point& point );
+    Index InsertPoints( const std::vector< Point >& points );
+    Index InsertPoints( const Scalar *pCoordinate, Index count, Index stride = 2 );
+    
+    // Streaming triangulation for point sets larger than memory, inside bounds known up front.
+    // No point of a chunk may have a smaller x than a point of an earlier chunk, as with an
+    // x-sorted file or tiles in column order. A triangle goes to callback( id1, id2, id3 ) once
+    // its circumcircle is behind the sweep line and no later point inside the bounds can see
+    // one of its hull edges, ids count the points in stream order, and only the front between
+    // finalized and unread points stays in memory. The triangles are those of Triangulation.
+    void BeginStream( const Point& min, const Point& max );
+    
+    template< typename Callback >
+    void StreamPoints( const Scalar *pCoordinate, Index count, Index stride, Callback callback )
+    {
+        InsertStream( pCoordinate, count, stride );
+        EmitFinal( callback );
+    }
+    
+    template< typename Callback >
+    void EndStream( Callback callback )
+    {
+        FinishStream();
+        EmitFinal( callback );
+    }
+    
+    // Remove points by id, the ids of the other points stay valid. Coincident points, exact
+    // duplicates and merged ones, share a vertex that stays until the last of them is removed.
+    // False for an id that is not in the mesh or already removed.
+    bool RemovePoint( Index id );
+    Index RemovePoints( const std::vector< Index >& ids );
+    
+    // Constrained triangulation. A segment between two points is forced into the mesh by
+    // flipping away the edges it crosses and stays there: flips leave it alone, new points
+    // do not see across it and a point landing on it splits it. Segments are kept through a
+    // rebuild, dropped with their end points, and fail when they would cross one another.
+    // A failed segment leaves no constraint behind, not even for the pieces between the
+    // points it runs through that were already in place.
+    bool InsertSegment( Index id1, Index id2 );
+    
+    // Closed loop of point ids, for outer boundaries and holes alike. When one of its segments
+    // fails, the segments put in before it are taken out again and none of the loop is left.
+    bool InsertPolygon( const std::vector< Index >& loop );
+    
+    // Removes the triangles outside of the polygons, that is those behind an even number
+    // of segments from the hull. Afterwards only Refine adds points to the mesh, InsertPoint
+    // and InsertPoints return NO_NEIGHBOR until the next Triangulation.
+    void RemoveExterior();
+    
+    // Delaunay refinement after Ruppert. Triangles with an angle below minAngle degrees or an
+    // area above maxArea ( 0 for no bound ) get their circumcenter inserted, worst first from
+    // a priority queue, and segments with a vertex inside their diametral circle are split.
+    // The boundary of the mesh becomes segments too. Bounds up to about 20 degrees terminate
+    // unless segments meet at sharper angles, maxPoints caps the number of new points.
+    // Returns the number of points added, their ids follow the existing ones.
+    Index Refine( double minAngle, double maxArea = 0.0, Index maxPoints = NO_NEIGHBOR );
+    
+    Point GetCircumcenter( Index triangle );
+    
+#ifdef DELAUNAY_STATS
+    // Counters since construction or the last reset, and the phases as a Chrome trace
+    const Statistics& GetStatistics() const { return m_Statistics; }
+    void ResetStatistics() { m_Statistics.Reset(); }
+    bool WriteTrace( const char *pFileName ) const { return m_Statistics.WriteTrace( pFileName ); }
+#endif
+    
 private:
+    struct CavityEdgeData
+    {
+        Index index1, index2;
+        Index outer;
+    };
+    
+    Engine                         m_Engine;
+    unsigned int                   m_ThreadCount;
     std::vector< TriangleData >    m_Triangles;
-    std::vector< Eigen::Vector2d > m_Points;
-    std::vector< unsigned long >   m_InitTrianglePointIndex;
+    std::vector< Point >           m_Points;
+    std::vector< Index >           m_PointIndex;
+    std::vector< Index >           m_PointVertex;
+    std::vector< Index >           m_RemovedVertex;
+    std::vector< Index >           m_MergeId;
+    Scalar                         m_MergeDistance;
+    std::vector< std::pair< Index, Index > > m_SpareVertex;
+    Index                          m_SpareCount;
+    
+    std::vector< bool >            m_TriangleAlive;
+    std::vector< Index >           m_TriangleMark;
+    std::vector< Index >           m_FreeTriangle;
+    std::vector< Index >           m_VertexLink;
+    
+    std::vector< Index >           m_Cavity;
+    std::vector< CavityEdgeData >  m_CavityBoundary;
+    std::vector< Index >           m_NewTriangle;
+    std::vector< std::pair< Index, int > > m_HullEdge;
+    std::vector< Index >           m_Ring;
+    std::vector< Index >           m_RingOuter;
+    std::vector< Index >           m_NearTriangle;
+    std::vector< Index >           m_BatchTriangle;
+    std::vector< std::pair< Index, int > > m_BatchEdge;
+    std::vector< double >          m_BatchCoordinate;
+    std::vector< double >          m_BatchResult;
+    std::vector< unsigned long long > m_SortKey;
+    Index                          m_LastTriangle;
+    Index                          m_Mark;
+    
+    std::set< EdgeData >           m_Constraint;
+    std::vector< EdgeData >        m_ConstraintPiece;
+    std::vector< EdgeData >        m_PolygonPiece;
+    std::vector< std::pair< Index, Index > > m_Crossing;
+    std::vector< std::pair< Index, Index > > m_SegmentEdge;
+    bool                           m_Exterior;
+    
+    bool                           m_Stream;
+    Index                          m_StreamCount;
+    Point                          m_StreamMin;
+    Point                          m_StreamMax;
+    std::vector< Index >           m_FinalTriangle;
+    std::set< EdgeData >           m_FrontEdge;
+    
+    // Mutable as the const tests count their predicates too
+#ifdef DELAUNAY_STATS
+    mutable Statistics             m_Statistics;
+#endif
+    
+    void SortPoint( const Scalar *pCoordinate, Index PointSize, Index stride, InsertionOrder order, std::vector< Index > *pIndex );
+    void MergePoint( const Scalar *pCoordinate, Index PointSize, Index stride, std::vector< Index > *pMergeId ) const;
+    void MergeInsertedPoint( const Scalar *pCoordinate, Index stride, const std::vector< Index >& order );
+    Index FindMergeTarget( const Point& point );
     
     void CreateInitTriangle();
-    void DeleteInitTriangle();
+    void LinkVertex();
+    
+    Index AllocateTriangle();
+    void FreeTriangle( Index triangle );
+    Index AddTriangle( Index index1, Index index2, Index index3 );
     
-    void AddTriangle( unsigned long index1, unsigned long index2, unsigned long index3 );
+    Index LocatePoint( const Point& point );
+    Index FindTriangle( const Point& point, int *pSide );
+    Index NextMark();
+    void FindCavity( const Point& point, Index start );
+    void AddCavityEdge( Index triangle, int side );
+    void InsertVertex( Index index );
+    void InsertOutside( Index index, Index triangle, int side );
+    void FindHullEdge( const Eigen::Vector2d& point, Index triangle, int side );
+    bool FlipEdge( Index triangle, int side );
+    void SwapEdge( Index triangle, int side );
+    void RestoreDelaunay();
+    void ReplaceNeighbor( Index triangle, Index from, Index to );
+    void LinkNeighbor( Index triangle, Index index1, Index index2, Index to );
+    
+    Index FindEdge( Index vertex1, Index vertex2, int *pSide ) const;
+    bool IsConstraint( Index vertex1, Index vertex2 ) const;
+    bool InsertConstraint( Index vertex1, Index vertex2 );
+    void AddConstraintPiece( Index vertex1, Index vertex2 );
+    void DropConstraintPiece();
+    void EnforceConstraint();
+    void FindInterior( std::vector< bool > *pInside ) const;
+    
+    void GetTriangleOrder( std::vector< Index > *pOrder ) const;
+    void GetVoronoiCell( Index vertex, const std::vector< Index >& order, std::vector< Index > *pCell, Point *pRay ) const;
+    
+    Index AddVertex( const Point& point );
+    void RemoveLastVertex();
+    Index WalkToward( Index triangle, const Point& point, EdgeData *pSegment ) const;
+    bool IsEncroached( Index vertex1, Index vertex2 ) const;
+    bool IsCorner( Index vertex, Index other, Index first ) const;
+    Index SplitSegment( Index vertex1, Index vertex2, Index first );
+    
+    // Calls visit( triangle, i ) for the triangles around vertex, which is their index[i],
+    // until it returns true and gives back that triangle
+    template< typename Visitor >
+    Index FindAround( Index vertex, Visitor visit ) const
+    {
+        Index start = m_VertexLink[vertex];
+        Index current;
+        int i, turn;
+        
+        if( start == NO_NEIGHBOR )
+            return NO_NEIGHBOR;
+        
+        // Counterclockwise first, then clockwise from the start when the star is open
+        for( turn = 1; turn <= 2; ++turn ) {
+            current = start;
+            
+            do {
+                for( i = 0; m_Triangles[current].index[i] != vertex; ++i );
+                
+                if( visit( current, i ) )
+                    return current;
+                
+                current = m_Triangles[current].neighbor[( i + turn ) % 3];
+            } while( current != NO_NEIGHBOR && current != start );
+            
+            if( current == start )
+                break;
+        }
+        
+        return NO_NEIGHBOR;
+    }
+    
+    bool RemoveVertex( Index vertex );
+    void FindSpareVertex();
+    void RemoveMarkedVertex();
+    bool IsEmptyEar( Index k ) const;
+    
+    void InsertStream( const Scalar *pCoordinate, Index count, Index stride );
+    void FinishStream();
+    void FinalizeStream( double sweep, bool all );
+    bool IsHullEdge( Index triangle, int side ) const;
+    bool IsHullFinal( Index triangle, int side, double sweep ) const;
+    void CompactStream();
+    
+    template< typename Callback >
+    void EmitFinal( Callback callback )
+    {
+        for( Index i = 0; i < m_FinalTriangle.size(); i += 3 ) {
+            callback( m_FinalTriangle[i], m_FinalTriangle[i + 1], m_FinalTriangle[i + 2] );
+        }
+        
+        m_FinalTriangle.clear();
+    }
+    
+    static Eigen::Vector2d ToDouble( const Point& point )
+    {
+        return point.template cast< double >();
+    }
 };
 
+}
+
 #endif /* Delaunay_hpp */
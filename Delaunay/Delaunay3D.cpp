@@ -0,0 +1,634 @@
+/*************************************************
+ * Copyright (c) 2017 Toru Ito
+ * Released under the MIT license
+ * http://opensource.org/licenses/mit-license.php
+ *************************************************/
+
+#include "Delaunay3D.hpp"
+#include <algorithm>
+
+template< typename Scalar, typename Index, typename Predicate >
+const Index Delaunay3D< Scalar, Index, Predicate >::NO_NEIGHBOR;
+
+template< typename Scalar, typename Index, typename Predicate >
+const Index Delaunay3D< Scalar, Index, Predicate >::INFINITE_VERTEX;
+
+template< typename Scalar, typename Index, typename Predicate >
+const int Delaunay3D< Scalar, Index, Predicate >::FACE[4][3] = { { 1, 3, 2 }, { 0, 2, 3 }, { 0, 3, 1 }, { 0, 1, 2 } };
+
+template< typename Scalar, typename Index, typename Predicate >
+Delaunay3D< Scalar, Index, Predicate >::Delaunay3D()
+    :m_LastTetrahedron( NO_NEIGHBOR )
+    ,m_Mark( 0 )
+    ,m_FiniteCount( 0 )
+{
+}
+
+template< typename Scalar, typename Index, typename Predicate >
+Delaunay3D< Scalar, Index, Predicate >::~Delaunay3D()
+{
+}
+
+template< typename Scalar, typename Index, typename Predicate >
+void Delaunay3D< Scalar, Index, Predicate >::SetPoint( std::vector< Point > *pPointList, InsertionOrder order )
+{
+    SetPoint( pPointList->empty() ? NULL : pPointList->front().data(), pPointList->size(), 3, order );
+}
+
+template< typename Scalar, typename Index, typename Predicate >
+void Delaunay3D< Scalar, Index, Predicate >::SetPoint( const Scalar *pCoordinate, Index count, Index stride, InsertionOrder order )
+{
+    SortPoint( pCoordinate, count, stride, order, &m_PointIndex );
+    
+    // The working copy is kept in insertion order
+    m_Points.clear();
+    m_Points.reserve( count );
+    
+    for( auto index : m_PointIndex ) {
+        m_Points.push_back( Point( pCoordinate[index * stride], pCoordinate[index * stride + 1], pCoordinate[index * stride + 2] ) );
+    }
+    
+    m_PointVertex.resize( count );
+    
+    for( Index i = 0; i < count; ++i ) {
+        m_PointVertex[m_PointIndex[i]] = i;
+    }
+}
+
+// Skilling's transform of the coordinates to the Hilbert curve, 16 bits per axis
+static unsigned long long HilbertIndex( unsigned long x, unsigned long y, unsigned long z )
+{
+    const int bits = 16;
+    unsigned long axis[3] = { x, y, z };
+    unsigned long p, q, t;
+    unsigned long long d = 0;
+    int i, b;
+    
+    for( q = 1ul << ( bits - 1 ); q > 1; q >>= 1 ) {
+        p = q - 1;
+        
+        for( i = 0; i < 3; ++i ) {
+            if( axis[i] & q ) {
+                axis[0] ^= p;
+            } else {
+                t = ( axis[0] ^ axis[i] ) & p;
+                axis[0] ^= t;
+                axis[i] ^= t;
+            }
+        }
+    }
+    
+    for( i = 1; i < 3; ++i ) {
+        axis[i] ^= axis[i - 1];
+    }
+    
+    for( t = 0, q = 1ul << ( bits - 1 ); q > 1; q >>= 1 ) {
+        if( axis[2] & q ) {
+            t ^= q - 1;
+        }
+    }
+    
+    for( i = 0; i < 3; ++i ) {
+        axis[i] ^= t;
+    }
+    
+    // The transposed index interleaves the bits of the three axes from the top
+    for( b = bits - 1; b >= 0; --b ) {
+        for( i = 0; i < 3; ++i ) {
+            d = ( d << 1 ) | ( ( axis[i] >> b ) & 1 );
+        }
+    }
+    
+    return d;
+}
+
+template< typename Scalar, typename Index, typename Predicate >
+void Delaunay3D< Scalar, Index, Predicate >::SortPoint( const Scalar *pCoordinate, Index PointSize, Index stride, InsertionOrder order, std::vector< Index > *pIndex )
+{
+    Index i;
+    
+    pIndex->resize( PointSize );
+    
+    for( i = 0; i < PointSize; ++i ) {
+        (*pIndex)[i] = i;
+    }
+    
+    if( order == INPUT_ORDER || PointSize < 4 )
+        return;
+    
+    Point min( pCoordinate[0], pCoordinate[1], pCoordinate[2] ), max = min;
+    
+    for( i = 0; i < PointSize; ++i ) {
+        Point point( pCoordinate[i * stride], pCoordinate[i * stride + 1], pCoordinate[i * stride + 2] );
+        min = min.cwiseMin( point );
+        max = max.cwiseMax( point );
+    }
+    
+    Eigen::Vector3d scale = ( max - min ).template cast< double >();
+    
+    for( int k = 0; k < 3; ++k ) {
+        scale[k] = ( scale[k] > 0.0 ) ? 65535.0 / scale[k] : 0.0;
+    }
+    
+    // The key holds the Hilbert index in its low 48 bits and, for BRIO, the round in the high bits
+    std::vector< unsigned long long >& keys = m_SortKey;
+    keys.resize( PointSize );
+    unsigned long long round;
+    unsigned long long seed = 2;
+    
+    for( i = 0; i < PointSize; ++i ) {
+        Point point( pCoordinate[i * stride], pCoordinate[i * stride + 1], pCoordinate[i * stride + 2] );
+        keys[i] = HilbertIndex( static_cast< unsigned long >( ( point.x() - min.x() ) * scale.x() ),
+                                static_cast< unsigned long >( ( point.y() - min.y() ) * scale.y() ),
+                                static_cast< unsigned long >( ( point.z() - min.z() ) * scale.z() ) );
+        
+        if( order == BRIO_ORDER ) {
+            // Each point survives into the next earlier round with probability 1/2
+            seed = seed * 6364136223846793005ull + 1442695040888963407ull;
+            
+            for( round = 15; round > 0 && ( ( seed >> ( 63 - round ) ) & 1 ); --round );
+            
+            keys[i] |= round << 48;
+        }
+    }
+    
+    std::sort( pIndex->begin(), pIndex->end(), [&keys]( Index a, Index b ) {
+        return keys[a] < keys[b];
+    });
+}
+
+// Exact, the three points are collinear when all their axis projections are
+template< typename Scalar, typename Index, typename Predicate >
+bool Delaunay3D< Scalar, Index, Predicate >::IsCollinear( Index vertex1, Index vertex2, Index vertex3 ) const
+{
+    const Eigen::Vector3d a = ToDouble( vertex1 ), b = ToDouble( vertex2 ), c = ToDouble( vertex3 );
+    
+    for( int k = 0; k < 3; ++k ) {
+        int u = ( k + 1 ) % 3, v = ( k + 2 ) % 3;
+        
+        if( Predicate::Orientation( Eigen::Vector2d( a[u], a[v] ), Eigen::Vector2d( b[u], b[v] ), Eigen::Vector2d( c[u], c[v] ) ) != 0.0 )
+            return false;
+    }
+    
+    return true;
+}
+
+// The first tetrahedron is made of input points in insertion order, the first two distinct
+// ones, the first point off their line and the first point off their plane. Each of its
+// faces gets an infinite tetrahedron on the outside.
+template< typename Scalar, typename Index, typename Predicate >
+bool Delaunay3D< Scalar, Index, Predicate >::CreateInitTetrahedron( Index *pVertex )
+{
+    Index PointSize = m_Points.size();
+    Index v0, v1, v2, v3, tet, infinite;
+    double orientation = 0.0;
+    int i;
+    
+    if( PointSize < 4 )
+        return false;
+    
+    v0 = 0;
+    
+    for( v1 = 1; v1 < PointSize && m_Points[v1] == m_Points[v0]; ++v1 );
+    for( v2 = v1 + 1; v2 < PointSize && IsCollinear( v0, v1, v2 ); ++v2 );
+    
+    for( v3 = v2 + 1; v3 < PointSize; ++v3 ) {
+        orientation = Predicate::Orientation3D( ToDouble( v0 ), ToDouble( v1 ), ToDouble( v2 ), ToDouble( v3 ) );
+        
+        if( orientation != 0.0 )
+            break;
+    }
+    
+    if( v3 >= PointSize )
+        return false;
+    
+    if( orientation < 0.0 ) {
+        std::swap( v1, v2 );
+    }
+    
+    pVertex[0] = v0;
+    pVertex[1] = v1;
+    pVertex[2] = v2;
+    pVertex[3] = v3;
+    
+    tet = AllocateTetrahedron();
+    
+    for( i = 0; i < 4; ++i ) {
+        m_Tetrahedra[tet].index[i] = pVertex[i];
+    }
+    
+    m_NewTetrahedron.clear();
+    ReserveEdgeTable( 4 );
+    
+    // Reversed, the face has the infinite vertex below and the finite one above
+    for( i = 0; i < 4; ++i ) {
+        const int *face = FACE[i];
+        
+        infinite = AllocateTetrahedron();
+        
+        TetrahedronData& outer = m_Tetrahedra[infinite];
+        outer.index[0] = pVertex[face[1]];
+        outer.index[1] = pVertex[face[0]];
+        outer.index[2] = pVertex[face[2]];
+        outer.index[3] = INFINITE_VERTEX;
+        outer.neighbor[3] = tet;
+        
+        m_Tetrahedra[tet].neighbor[i] = infinite;
+        m_NewTetrahedron.push_back( infinite );
+    }
+    
+    for( auto ghost : m_NewTetrahedron ) {
+        LinkApex( ghost );
+    }
+    
+    for( auto slot : m_EdgeSlot ) {
+        m_EdgeTable[slot].tetrahedron = NO_NEIGHBOR;
+    }
+    
+    m_EdgeSlot.clear();
+    m_LastTetrahedron = tet;
+    m_FiniteCount = 1;
+    
+    return true;
+}
+
+template< typename Scalar, typename Index, typename Predicate >
+Index Delaunay3D< Scalar, Index, Predicate >::AllocateTetrahedron()
+{
+    if( !m_FreeTetrahedron.empty() ) {
+        Index tet = m_FreeTetrahedron.back();
+        m_FreeTetrahedron.pop_back();
+        m_TetrahedronAlive[tet] = true;
+        return tet;
+    }
+    
+    m_Tetrahedra.push_back( TetrahedronData() );
+    m_TetrahedronAlive.push_back( true );
+    m_TetrahedronMark.push_back( 0 );
+    
+    return m_Tetrahedra.size() - 1;
+}
+
+template< typename Scalar, typename Index, typename Predicate >
+void Delaunay3D< Scalar, Index, Predicate >::FreeTetrahedron( Index tetrahedron )
+{
+    m_TetrahedronAlive[tetrahedron] = false;
+    m_FreeTetrahedron.push_back( tetrahedron );
+}
+
+template< typename Scalar, typename Index, typename Predicate >
+void Delaunay3D< Scalar, Index, Predicate >::Triangulation()
+{
+    Index vertex[4];
+    
+    m_Tetrahedra.clear();
+    m_TetrahedronAlive.clear();
+    m_TetrahedronMark.clear();
+    m_FreeTetrahedron.clear();
+    m_Mark = 0;
+    m_FiniteCount = 0;
+    m_LastTetrahedron = NO_NEIGHBOR;
+    
+    // About 6.5 finite and a few infinite tetrahedra per point
+    m_Tetrahedra.reserve( 7 * m_Points.size() );
+    m_TetrahedronAlive.reserve( 7 * m_Points.size() );
+    m_TetrahedronMark.reserve( 7 * m_Points.size() );
+    
+    if( !CreateInitTetrahedron( vertex ) )
+        return;
+    
+    for( Index index = 0; index < m_Points.size(); ++index ) {
+        if( index != vertex[0] && index != vertex[1] && index != vertex[2] && index != vertex[3] ) {
+            InsertVertex( index );
+        }
+    }
+}
+
+// Visibility walk, it leaves through a face the point lies above. The first face to test is
+// picked at random, which keeps the walk from cycling. Stops at an infinite tetrahedron when
+// the point is outside of the hull.
+template< typename Scalar, typename Index, typename Predicate >
+Index Delaunay3D< Scalar, Index, Predicate >::LocatePoint( const Eigen::Vector3d& point )
+{
+    Index current = m_LastTetrahedron;
+    Index previous = NO_NEIGHBOR;
+    Index seed = current;
+    int i, k, start;
+    bool moved;
+    
+    if( IsInfinite( current ) ) {
+        for( i = 0; m_Tetrahedra[current].index[i] != INFINITE_VERTEX; ++i );
+        
+        current = m_Tetrahedra[current].neighbor[i];
+    }
+    
+    do {
+        const TetrahedronData& tet = m_Tetrahedra[current];
+        
+        seed = seed * 1103515245ul + 12345ul;
+        start = static_cast< int >( ( seed >> 16 ) % 4 );
+        moved = false;
+        
+        for( k = 0; k < 4; ++k ) {
+            i = ( start + k ) % 4;
+            
+            if( tet.neighbor[i] == previous )
+                continue;
+            
+            const int *face = FACE[i];
+            
+            if( Predicate::Orientation3D( ToDouble( tet.index[face[0]] ), ToDouble( tet.index[face[1]] ), ToDouble( tet.index[face[2]] ), point ) < 0.0 ) {
+                previous = current;
+                current = tet.neighbor[i];
+                moved = true;
+                break;
+            }
+        }
+    
+    } while( moved && !IsInfinite( current ) );
+    
+    return current;
+}
+
+// Every cavity search needs two fresh mark values, all marks are cleared when they run out
+template< typename Scalar, typename Index, typename Predicate >
+Index Delaunay3D< Scalar, Index, Predicate >::NextMark()
+{
+    if( m_Mark >= NO_NEIGHBOR - 2 ) {
+        std::fill( m_TetrahedronMark.begin(), m_TetrahedronMark.end(), 0 );
+        m_Mark = 0;
+    }
+    
+    m_Mark += 2;
+    
+    return m_Mark - 1;
+}
+
+// A finite tetrahedron is in conflict with a point inside its circumsphere. An infinite one
+// is when the point lies above its hull face, on the side of the infinite vertex, and on the
+// plane of the face when it is in conflict with the finite tetrahedron behind the face.
+template< typename Scalar, typename Index, typename Predicate >
+bool Delaunay3D< Scalar, Index, Predicate >::IsConflict( Index tetrahedron, const Eigen::Vector3d& point )
+{
+    const TetrahedronData& tet = m_Tetrahedra[tetrahedron];
+    int k;
+    
+    for( k = 0; k < 4 && tet.index[k] != INFINITE_VERTEX; ++k );
+    
+    if( k == 4 )
+        return Predicate::InSphere( ToDouble( tet.index[0] ), ToDouble( tet.index[1] ), ToDouble( tet.index[2] ), ToDouble( tet.index[3] ), point ) > 0.0;
+    
+    const int *face = FACE[k];
+    double orientation = Predicate::Orientation3D( ToDouble( tet.index[face[0]] ), ToDouble( tet.index[face[1]] ), ToDouble( tet.index[face[2]] ), point );
+    
+    if( orientation != 0.0 )
+        return orientation > 0.0;
+    
+    return IsConflict( tet.neighbor[k], point );
+}
+
+// Breadth-first from the start over the tetrahedra in conflict. The new tetrahedra join the
+// point to the boundary faces, a flat or inverted one only comes from a degenerate cavity
+// and the tetrahedron behind its face is added, which the point cannot lie outside of.
+template< typename Scalar, typename Index, typename Predicate >
+void Delaunay3D< Scalar, Index, Predicate >::FindCavity( const Eigen::Vector3d& point, Index start )
+{
+    const Index inside = NextMark();
+    const Index outside = inside + 1;
+    Index current, next, k, begin;
+    int i, j;
+    bool grown;
+    
+    m_Cavity.clear();
+    m_TetrahedronMark[start] = inside;
+    m_Cavity.push_back( start );
+    
+    for( begin = 0; ; ) {
+        for( ; begin < m_Cavity.size(); ++begin ) {
+            current = m_Cavity[begin];
+            
+            for( i = 0; i < 4; ++i ) {
+                next = m_Tetrahedra[current].neighbor[i];
+                
+                if( m_TetrahedronMark[next] == inside || m_TetrahedronMark[next] == outside )
+                    continue;
+                
+                if( IsConflict( next, point ) ) {
+                    m_TetrahedronMark[next] = inside;
+                    m_Cavity.push_back( next );
+                } else {
+                    m_TetrahedronMark[next] = outside;
+                }
+            }
+        }
+        
+        m_CavityFace.clear();
+        grown = false;
+        
+        for( k = 0; k < m_Cavity.size(); ++k ) {
+            current = m_Cavity[k];
+            const TetrahedronData& tet = m_Tetrahedra[current];
+            
+            for( i = 0; i < 4; ++i ) {
+                next = tet.neighbor[i];
+                
+                if( m_TetrahedronMark[next] == inside )
+                    continue;
+                
+                CavityFaceData face;
+                face.index[0] = tet.index[FACE[i][0]];
+                face.index[1] = tet.index[FACE[i][1]];
+                face.index[2] = tet.index[FACE[i][2]];
+                face.outer = next;
+                
+                if( face.index[0] != INFINITE_VERTEX && face.index[1] != INFINITE_VERTEX && face.index[2] != INFINITE_VERTEX &&
+                    Predicate::Orientation3D( ToDouble( face.index[0] ), ToDouble( face.index[1] ), ToDouble( face.index[2] ), point ) <= 0.0 ) {
+                    m_TetrahedronMark[next] = inside;
+                    m_Cavity.push_back( next );
+                    grown = true;
+                    continue;
+                }
+                
+                for( j = 0; m_Tetrahedra[next].neighbor[j] != current; ++j );
+                
+                face.outerSide = j;
+                m_CavityFace.push_back( face );
+            }
+        }
+        
+        if( !grown )
+            break;
+    }
+}
+
+template< typename Scalar, typename Index, typename Predicate >
+void Delaunay3D< Scalar, Index, Predicate >::InsertVertex( Index index )
+{
+    const Eigen::Vector3d point = ToDouble( index );
+    Index current, tet, k;
+    int i;
+    
+    current = LocatePoint( point );
+    
+    // A point coinciding with an existing vertex would only add flat tetrahedra
+    if( !IsInfinite( current ) ) {
+        for( i = 0; i < 4; ++i ) {
+            if( m_Points[m_Tetrahedra[current].index[i]] == m_Points[index] )
+                return;
+        }
+    }
+    
+    FindCavity( point, current );
+    
+    for( auto cavity : m_Cavity ) {
+        if( !IsInfinite( cavity ) ) {
+            --m_FiniteCount;
+        }
+    }
+    
+    ReserveEdgeTable( m_CavityFace.size() );
+    
+    // Retriangulate in the slots of the cavity, the point is the apex of every new tetrahedron
+    m_NewTetrahedron.clear();
+    
+    for( k = 0; k < m_CavityFace.size(); ++k ) {
+        const CavityFaceData& face = m_CavityFace[k];
+        
+        tet = ( k < m_Cavity.size() ) ? m_Cavity[k] : AllocateTetrahedron();
+        
+        TetrahedronData& data = m_Tetrahedra[tet];
+        data.index[0] = face.index[0];
+        data.index[1] = face.index[1];
+        data.index[2] = face.index[2];
+        data.index[3] = index;
+        data.neighbor[3] = face.outer;
+        
+        m_Tetrahedra[face.outer].neighbor[face.outerSide] = tet;
+        m_NewTetrahedron.push_back( tet );
+    }
+    
+    for( k = m_CavityFace.size(); k < m_Cavity.size(); ++k ) {
+        FreeTetrahedron( m_Cavity[k] );
+    }
+    
+    for( auto created : m_NewTetrahedron ) {
+        LinkApex( created );
+        
+        if( !IsInfinite( created ) ) {
+            ++m_FiniteCount;
+            m_LastTetrahedron = created;
+        }
+    }
+    
+    for( auto slot : m_EdgeSlot ) {
+        m_EdgeTable[slot].tetrahedron = NO_NEIGHBOR;
+    }
+    
+    m_EdgeSlot.clear();
+}
+
+// Each edge of the boundary is shared by two new tetrahedra, the table pairs them up. It is
+// kept at least four times the number of new tetrahedra so an empty slot is found quickly.
+template< typename Scalar, typename Index, typename Predicate >
+void Delaunay3D< Scalar, Index, Predicate >::ReserveEdgeTable( size_t count )
+{
+    size_t size;
+    
+    for( size = 16; size < 4 * count; size <<= 1 );
+    
+    if( m_EdgeTable.size() < size ) {
+        EdgeEntry empty;
+        empty.tetrahedron = NO_NEIGHBOR;
+        m_EdgeTable.assign( size, empty );
+    }
+}
+
+// Links the face opposite index[side], which holds the apex index[3] and the edge from index1
+// to index2, with the other new tetrahedron on that edge once both have been seen
+template< typename Scalar, typename Index, typename Predicate >
+void Delaunay3D< Scalar, Index, Predicate >::LinkFace( Index tetrahedron, int side, Index index1, Index index2 )
+{
+    const size_t mask = m_EdgeTable.size() - 1;
+    
+    if( index1 > index2 ) {
+        std::swap( index1, index2 );
+    }
+    
+    unsigned long long hash = static_cast< unsigned long long >( index1 ) * 0x9e3779b97f4a7c15ull ^ static_cast< unsigned long long >( index2 ) * 0xc2b2ae3d27d4eb4full;
+    size_t slot = static_cast< size_t >( hash ^ ( hash >> 32 ) ) & mask;
+    
+    for( ; m_EdgeTable[slot].tetrahedron != NO_NEIGHBOR; slot = ( slot + 1 ) & mask ) {
+        EdgeEntry& entry = m_EdgeTable[slot];
+        
+        if( entry.index1 == index1 && entry.index2 == index2 ) {
+            m_Tetrahedra[tetrahedron].neighbor[side] = entry.tetrahedron;
+            m_Tetrahedra[entry.tetrahedron].neighbor[entry.side] = tetrahedron;
+            return;
+        }
+    }
+    
+    EdgeEntry& entry = m_EdgeTable[slot];
+    entry.index1 = index1;
+    entry.index2 = index2;
+    entry.tetrahedron = tetrahedron;
+    entry.side = side;
+    m_EdgeSlot.push_back( slot );
+}
+
+template< typename Scalar, typename Index, typename Predicate >
+void Delaunay3D< Scalar, Index, Predicate >::LinkApex( Index tetrahedron )
+{
+    const Index *index = m_Tetrahedra[tetrahedron].index;
+    
+    LinkFace( tetrahedron, 0, index[1], index[2] );
+    LinkFace( tetrahedron, 1, index[0], index[2] );
+    LinkFace( tetrahedron, 2, index[0], index[1] );
+}
+
+// Position of every finite tetrahedron in the output, NO_NEIGHBOR for the others
+template< typename Scalar, typename Index, typename Predicate >
+void Delaunay3D< Scalar, Index, Predicate >::GetTetrahedronOrder( std::vector< Index > *pOrder ) const
+{
+    Index count = 0;
+    
+    pOrder->assign( m_Tetrahedra.size(), NO_NEIGHBOR );
+    
+    for( Index i = 0; i < m_Tetrahedra.size(); ++i ) {
+        if( m_TetrahedronAlive[i] && !IsInfinite( i ) ) {
+            (*pOrder)[i] = count++;
+        }
+    }
+}
+
+template< typename Scalar, typename Index, typename Predicate >
+void Delaunay3D< Scalar, Index, Predicate >::GetResult( Index *pIndexBuffer ) const
+{
+    ForEachTetrahedron( [&pIndexBuffer]( Index id1, Index id2, Index id3, Index id4 ) {
+        *pIndexBuffer++ = id1;
+        *pIndexBuffer++ = id2;
+        *pIndexBuffer++ = id3;
+        *pIndexBuffer++ = id4;
+    });
+}
+
+template< typename Scalar, typename Index, typename Predicate >
+void Delaunay3D< Scalar, Index, Predicate >::GetNeighbor( Index *pNeighborBuffer ) const
+{
+    std::vector< Index > order;
+    
+    GetTetrahedronOrder( &order );
+    
+    for( Index i = 0; i < m_Tetrahedra.size(); ++i ) {
+        if( order[i] == NO_NEIGHBOR )
+            continue;
+        
+        for( int k = 0; k < 4; ++k ) {
+            *pNeighborBuffer++ = order[m_Tetrahedra[i].neighbor[k]];
+        }
+    }
+}
+
+template class Delaunay3D< double, uint32_t, ExactPredicate >;
+template class Delaunay3D< double, uint64_t, ExactPredicate >;
+template class Delaunay3D< float, uint32_t, ExactPredicate >;
+template class Delaunay3D< double, uint32_t, FastPredicate >;
@@ -0,0 +1,150 @@
+/*************************************************
+ * Copyright (c) 2017 Toru Ito
+ * Released under the MIT license
+ * http://opensource.org/licenses/mit-license.php
+ *************************************************/
+
+#ifndef Delaunay3D_hpp
+#define Delaunay3D_hpp
+
+#include <stdio.h>
+#include <vector>
+#include <Eigen/Core>
+#include <Eigen/Geometry>
+#include <stdint.h>
+#include "Predicates.hpp"
+
+// Delaunay tetrahedralization, the 3D counterpart of Delaunay's Bowyer-Watson engine. The
+// points are inserted in Hilbert or BRIO order, each is located by a walk from the last new
+// tetrahedron and its cavity of tetrahedra with the point inside their circumsphere is
+// replaced by a star. The outer space is covered by infinite tetrahedra, one per hull face
+// with the infinite vertex as the fourth corner, so every face has a neighbor and points
+// outside the hull need no bounding vertices.
+template< typename Scalar = double, typename Index = uint32_t, typename Predicate = ExactPredicate >
+class Delaunay3D
+{
+public:
+    typedef Eigen::Matrix< Scalar, 3, 1 > Point;
+    
+    static const Index NO_NEIGHBOR = static_cast< Index >( -1 );
+    static const Index INFINITE_VERTEX = static_cast< Index >( -2 );
+    
+    enum InsertionOrder
+    {
+        INPUT_ORDER,
+        HILBERT_ORDER,
+        BRIO_ORDER
+    };
+    
+    // Positively oriented, Predicate::Orientation3D( index[0], index[1], index[2], index[3] ) > 0,
+    // and neighbor[i] is across the face opposite index[i]
+    struct TetrahedronData
+    {
+        Index   index[4];
+        Index   neighbor[4];
+    };
+
+public:
+    Delaunay3D();
+    ~Delaunay3D();
+    
+    void SetPoint( std::vector< Point > *pPointList, InsertionOrder order = BRIO_ORDER );
+    
+    // Non-owning view of count points, point i is pCoordinate[i * stride] to pCoordinate[i * stride + 2]
+    void SetPoint( const Scalar *pCoordinate, Index count, Index stride = 3, InsertionOrder order = BRIO_ORDER );
+    
+    // Coincident points get no tetrahedron, all coplanar input gives none at all
+    void Triangulation();
+    
+    // Writes 4 * GetTetrahedronCount() point ids into pIndexBuffer
+    Index GetTetrahedronCount() const { return m_FiniteCount; }
+    void GetResult( Index *pIndexBuffer ) const;
+    
+    // The same number of tetrahedron indices in GetResult order, NO_NEIGHBOR on the hull
+    void GetNeighbor( Index *pNeighborBuffer ) const;
+    
+    Index GetPointCount() const { return m_PointIndex.size(); }
+    Point GetPoint( Index id ) const { return m_Points[m_PointVertex[id]]; }
+    
+    // Calls callback( id1, id2, id3, id4 ) for every finite tetrahedron without any buffer
+    template< typename Callback >
+    void ForEachTetrahedron( Callback callback ) const
+    {
+        for( Index i = 0; i < m_Tetrahedra.size(); ++i ) {
+            if( !m_TetrahedronAlive[i] || IsInfinite( i ) )
+                continue;
+            
+            const TetrahedronData& tet = m_Tetrahedra[i];
+            callback( m_PointIndex[tet.index[0]], m_PointIndex[tet.index[1]], m_PointIndex[tet.index[2]], m_PointIndex[tet.index[3]] );
+        }
+    }
+    
+    // The vertices of the face opposite corner i, ordered so that the corner lies below them
+    static const int FACE[4][3];
+
+private:
+    struct EdgeEntry
+    {
+        Index   index1, index2;
+        Index   tetrahedron;
+        int     side;
+    };
+    
+    // A face of the cavity boundary, seen from inside, and where the tetrahedron behind it links back
+    struct CavityFaceData
+    {
+        Index   index[3];
+        Index   outer;
+        int     outerSide;
+    };
+    
+    std::vector< TetrahedronData >  m_Tetrahedra;
+    std::vector< Point >            m_Points;
+    std::vector< Index >            m_PointIndex;
+    std::vector< Index >            m_PointVertex;
+    
+    std::vector< bool >             m_TetrahedronAlive;
+    std::vector< Index >            m_TetrahedronMark;
+    std::vector< Index >            m_FreeTetrahedron;
+    
+    std::vector< Index >            m_Cavity;
+    std::vector< CavityFaceData >   m_CavityFace;
+    std::vector< Index >            m_NewTetrahedron;
+    std::vector< EdgeEntry >        m_EdgeTable;
+    std::vector< size_t >           m_EdgeSlot;
+    std::vector< unsigned long long > m_SortKey;
+    Index                           m_LastTetrahedron;
+    Index                           m_Mark;
+    Index                           m_FiniteCount;
+    
+    void SortPoint( const Scalar *pCoordinate, Index PointSize, Index stride, InsertionOrder order, std::vector< Index > *pIndex );
+    
+    bool IsCollinear( Index vertex1, Index vertex2, Index vertex3 ) const;
+    bool CreateInitTetrahedron( Index *pVertex );
+    Index AllocateTetrahedron();
+    void FreeTetrahedron( Index tetrahedron );
+    
+    Index LocatePoint( const Eigen::Vector3d& point );
+    Index NextMark();
+    bool IsConflict( Index tetrahedron, const Eigen::Vector3d& point );
+    void FindCavity( const Eigen::Vector3d& point, Index start );
+    void InsertVertex( Index index );
+    void ReserveEdgeTable( size_t count );
+    void LinkFace( Index tetrahedron, int side, Index index1, Index index2 );
+    void LinkApex( Index tetrahedron );
+    void GetTetrahedronOrder( std::vector< Index > *pOrder ) const;
+    
+    bool IsInfinite( Index tetrahedron ) const
+    {
+        const TetrahedronData& tet = m_Tetrahedra[tetrahedron];
+        
+        return tet.index[0] == INFINITE_VERTEX || tet.index[1] == INFINITE_VERTEX || tet.index[2] == INFINITE_VERTEX || tet.index[3] == INFINITE_VERTEX;
+    }
+    
+    Eigen::Vector3d ToDouble( Index vertex ) const
+    {
+        return m_Points[vertex].template cast< double >();
+    }
+};
+
+#endif /* Delaunay3D_hpp */
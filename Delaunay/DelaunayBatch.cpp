@@ -0,0 +1,189 @@
+/*************************************************
+ * Copyright (c) 2017 Toru Ito
+ * Released under the MIT license
+ * http://opensource.org/licenses/mit-license.php
+ *************************************************/
+
+#include "DelaunayBatch.hpp"
+#include <thread>
+
+template< typename Scalar, typename Index, typename Predicate >
+DelaunayBatch< Scalar, Index, Predicate >::DelaunayBatch()
+    :m_ThreadCount( 1 )
+{
+    SetThreadCount( 0 );
+}
+
+template< typename Scalar, typename Index, typename Predicate >
+DelaunayBatch< Scalar, Index, Predicate >::~DelaunayBatch()
+{
+}
+
+template< typename Scalar, typename Index, typename Predicate >
+void DelaunayBatch< Scalar, Index, Predicate >::SetThreadCount( unsigned int count )
+{
+    if( count == 0 ) {
+        count = std::thread::hardware_concurrency();
+    }
+    
+    m_ThreadCount = ( count > 0 ) ? count : 1;
+}
+
+template< typename Scalar, typename Index, typename Predicate >
+void DelaunayBatch< Scalar, Index, Predicate >::Triangulation( const Scalar *pCoordinate, const size_t *pPointOffset, size_t setCount,
+                                                               std::vector< Index > *pIndex, std::vector< size_t > *pTriangleOffset )
+{
+    unsigned int threads = static_cast< unsigned int >( std::min< size_t >( m_ThreadCount, std::max< size_t >( setCount, 1 ) ) );
+    std::vector< std::thread > pool;
+    unsigned int k;
+    size_t set;
+    
+    // The workers and their buffers stay for the next batch
+    while( m_Worker.size() < threads ) {
+        m_Worker.push_back( std::unique_ptr< Worker >( new Worker() ) );
+    }
+    
+    for( k = 0; k < m_Worker.size(); ++k ) {
+        Worker& worker = *m_Worker[k];
+        worker.index.clear();
+        worker.set.clear();
+        worker.start.clear();
+        worker.begin = ( k < threads ) ? setCount * k / threads : 0;
+        worker.end = ( k < threads ) ? setCount * ( k + 1 ) / threads : 0;
+    }
+    
+    pTriangleOffset->assign( setCount + 1, 0 );
+    
+    // The calling thread is worker 0
+    for( k = 1; k < threads; ++k ) {
+        pool.push_back( std::thread( &DelaunayBatch::Run, this, k, pCoordinate, pPointOffset, pTriangleOffset ) );
+    }
+    
+    Run( 0, pCoordinate, pPointOffset, pTriangleOffset );
+    
+    for( auto& thread : pool ) {
+        thread.join();
+    }
+    
+    // Until now entry k + 1 held the triangle count of set k
+    for( set = 0; set < setCount; ++set ) {
+        ( *pTriangleOffset )[set + 1] += ( *pTriangleOffset )[set];
+    }
+    
+    pIndex->resize( 3 * pTriangleOffset->back() );
+    pool.clear();
+    
+    for( k = 1; k < threads; ++k ) {
+        pool.push_back( std::thread( &DelaunayBatch::Copy, this, k, pIndex, std::cref( *pTriangleOffset ) ) );
+    }
+    
+    Copy( 0, pIndex, *pTriangleOffset );
+    
+    for( auto& thread : pool ) {
+        thread.join();
+    }
+}
+
+// The next set from the front of the own share, or else the back half of the largest other share
+template< typename Scalar, typename Index, typename Predicate >
+bool DelaunayBatch< Scalar, Index, Predicate >::TakeSet( unsigned int worker, size_t *pSet )
+{
+    Worker& self = *m_Worker[worker];
+    
+    {
+        std::lock_guard< std::mutex > lock( self.mutex );
+        
+        if( self.begin < self.end ) {
+            *pSet = self.begin++;
+            return true;
+        }
+    }
+    
+    for( ;; ) {
+        unsigned int victim = worker;
+        size_t most = 0, begin, end;
+        
+        // The share may shrink before the steal, which then looks again
+        for( unsigned int k = 0; k < m_Worker.size(); ++k ) {
+            Worker& other = *m_Worker[k];
+            std::lock_guard< std::mutex > lock( other.mutex );
+            
+            if( other.end > other.begin && other.end - other.begin > most ) {
+                most = other.end - other.begin;
+                victim = k;
+            }
+        }
+        
+        if( victim == worker )
+            return false;
+        
+        {
+            Worker& other = *m_Worker[victim];
+            std::lock_guard< std::mutex > lock( other.mutex );
+            
+            if( other.begin >= other.end )
+                continue;
+            
+            end = other.end;
+            begin = other.end - ( other.end - other.begin + 1 ) / 2;
+            other.end = begin;
+        }
+        
+        std::lock_guard< std::mutex > lock( self.mutex );
+        *pSet = begin;
+        self.begin = begin + 1;
+        self.end = end;
+        
+        return true;
+    }
+}
+
+template< typename Scalar, typename Index, typename Predicate >
+void DelaunayBatch< Scalar, Index, Predicate >::Run( unsigned int worker, const Scalar *pCoordinate, const size_t *pPointOffset, std::vector< size_t > *pTriangleOffset )
+{
+    Worker& self = *m_Worker[worker];
+    Delaunay< Scalar, Index, Predicate >& delaunay = self.delaunay;
+    size_t set;
+    
+    while( TakeSet( worker, &set ) ) {
+        size_t count = pPointOffset[set + 1] - pPointOffset[set];
+        
+        if( count < 3 )
+            continue;
+        
+        // Hilbert order keeps the point location walks short even on small sets
+        delaunay.SetPoint( pCoordinate + 2 * pPointOffset[set], static_cast< Index >( count ), 2, Delaunay< Scalar, Index, Predicate >::HILBERT_ORDER );
+        delaunay.Triangulation();
+        
+        size_t start = self.index.size();
+        Index triangles = delaunay.GetTriangleCount();
+        
+        self.index.resize( start + 3 * static_cast< size_t >( triangles ) );
+        
+        if( triangles > 0 ) {
+            delaunay.GetResult( &self.index[start] );
+        }
+        
+        self.set.push_back( set );
+        self.start.push_back( start );
+        ( *pTriangleOffset )[set + 1] = triangles;
+    }
+}
+
+template< typename Scalar, typename Index, typename Predicate >
+void DelaunayBatch< Scalar, Index, Predicate >::Copy( unsigned int worker, std::vector< Index > *pIndex, const std::vector< size_t >& TriangleOffset )
+{
+    const Worker& self = *m_Worker[worker];
+    
+    for( size_t k = 0; k < self.set.size(); ++k ) {
+        size_t set = self.set[k];
+        size_t size = 3 * ( TriangleOffset[set + 1] - TriangleOffset[set] );
+        
+        std::copy( self.index.begin() + self.start[k], self.index.begin() + self.start[k] + size, pIndex->begin() + 3 * TriangleOffset[set] );
+    }
+}
+
+template class DelaunayBatch< double, uint32_t, ExactPredicate >;
+template class DelaunayBatch< double, uint64_t, ExactPredicate >;
+template class DelaunayBatch< float, uint32_t, ExactPredicate >;
+template class DelaunayBatch< double, uint32_t, FastPredicate >;
@@ -0,0 +1,61 @@
+/*************************************************
+ * Copyright (c) 2017 Toru Ito
+ * Released under the MIT license
+ * http://opensource.org/licenses/mit-license.php
+ *************************************************/
+
+#ifndef DelaunayBatch_hpp
+#define DelaunayBatch_hpp
+
+#include <stdio.h>
+#include <stddef.h>
+#include <vector>
+#include <memory>
+#include <mutex>
+
+#include "Delaunay.hpp"
+
+// Triangulates many small independent point sets at once. Every thread keeps one Delaunay
+// whose buffers are reused from set to set, so after the first sets there is next to no
+// allocation. Each thread starts on its own share of the sets and, once done, steals half
+// of what is left of the busiest other share.
+template< typename Scalar = double, typename Index = uint32_t, typename Predicate = ExactPredicate >
+class DelaunayBatch
+{
+public:
+    DelaunayBatch();
+    ~DelaunayBatch();
+    
+    // 0 uses every hardware thread
+    void SetThreadCount( unsigned int count );
+    
+    // Set k is made of the points pPointOffset[k] to pPointOffset[k + 1] - 1, point i being
+    // ( pCoordinate[2 * i], pCoordinate[2 * i + 1] ). Its triangles go to pIndex from
+    // ( *pTriangleOffset )[k] to ( *pTriangleOffset )[k + 1] - 1, three point indices within
+    // the set each, counterclockwise. Sets of fewer than three points have no triangles.
+    void Triangulation( const Scalar *pCoordinate, const size_t *pPointOffset, size_t setCount,
+                        std::vector< Index > *pIndex, std::vector< size_t > *pTriangleOffset );
+    
+private:
+    struct Worker
+    {
+        Delaunay< Scalar, Index, Predicate >  delaunay;
+        std::vector< Index >                  index;
+        std::vector< size_t >                 set;
+        std::vector< size_t >                 start;
+        
+        // The sets this worker has not taken yet, guarded by mutex as others steal from the end
+        std::mutex                            mutex;
+        size_t                                begin;
+        size_t                                end;
+    };
+    
+    unsigned int                              m_ThreadCount;
+    std::vector< std::unique_ptr< Worker > >  m_Worker;
+    
+    bool TakeSet( unsigned int worker, size_t *pSet );
+    void Run( unsigned int worker, const Scalar *pCoordinate, const size_t *pPointOffset, std::vector< size_t > *pTriangleOffset );
+    void Copy( unsigned int worker, std::vector< Index > *pIndex, const std::vector< size_t >& TriangleOffset );
+};
+
+#endif /* DelaunayBatch_hpp */
@@ -0,0 +1,342 @@
+/*************************************************
+ * Copyright (c) 2017 Toru Ito
+ * Released under the MIT license
+ * http://opensource.org/licenses/mit-license.php
+ *************************************************/
+
+#include "DelaunayQuery.hpp"
+#include <atomic>
+#include <thread>
+
+// Queries are handed out in blocks of this size
+static const size_t QUERY_BLOCK = 4096;
+
+// Beyond this the grid would outgrow the mesh it indexes
+static const unsigned long MAX_GRID_SIZE = 2048;
+
+template< typename Scalar, typename Index, typename Predicate >
+const Index DelaunayQuery< Scalar, Index, Predicate >::NO_TRIANGLE;
+
+template< typename Scalar, typename Index, typename Predicate >
+DelaunayQuery< Scalar, Index, Predicate >::DelaunayQuery()
+    :m_GridSize( 0 )
+    ,m_Min( 0.0, 0.0 )
+    ,m_Scale( 0.0, 0.0 )
+    ,m_ThreadCount( 1 )
+{
+    SetThreadCount( 0 );
+}
+
+template< typename Scalar, typename Index, typename Predicate >
+DelaunayQuery< Scalar, Index, Predicate >::~DelaunayQuery()
+{
+}
+
+template< typename Scalar, typename Index, typename Predicate >
+void DelaunayQuery< Scalar, Index, Predicate >::SetThreadCount( unsigned int count )
+{
+    if( count == 0 ) {
+        count = std::thread::hardware_concurrency();
+    }
+    
+    m_ThreadCount = ( count > 0 ) ? count : 1;
+}
+
+template< typename Scalar, typename Index, typename Predicate >
+void DelaunayQuery< Scalar, Index, Predicate >::Build( const Delaunay< Scalar, Index, Predicate >& delaunay )
+{
+    Index triangleCount = delaunay.GetTriangleCount();
+    Index pointCount = delaunay.GetPointCount();
+    Index i, x, y;
+    int k;
+    
+    m_Point.resize( pointCount );
+    m_Index.resize( 3 * triangleCount );
+    m_Neighbor.resize( 3 * triangleCount );
+    m_VertexLink.assign( pointCount, NO_TRIANGLE );
+    m_Grid.clear();
+    m_GridSize = 0;
+    
+    if( triangleCount == 0 )
+        return;
+    
+    for( i = 0; i < pointCount; ++i ) {
+        m_Point[i] = delaunay.GetPoint( i ).template cast< double >();
+    }
+    
+    delaunay.GetResult( &m_Index[0] );
+    delaunay.GetNeighbor( &m_Neighbor[0] );
+    
+    m_Min = m_Point[m_Index[0]];
+    Eigen::Vector2d max = m_Min;
+    
+    for( i = 0; i < m_Index.size(); ++i ) {
+        m_VertexLink[m_Index[i]] = i / 3;
+        m_Min = m_Min.cwiseMin( m_Point[m_Index[i]] );
+        max = max.cwiseMax( m_Point[m_Index[i]] );
+    }
+    
+    m_GridSize = static_cast< Index >( std::min( MAX_GRID_SIZE, static_cast< unsigned long >( std::sqrt( triangleCount / 2.0 ) ) + 1 ) );
+    m_Scale.x() = ( max.x() > m_Min.x() ) ? m_GridSize / ( max.x() - m_Min.x() ) : 0.0;
+    m_Scale.y() = ( max.y() > m_Min.y() ) ? m_GridSize / ( max.y() - m_Min.y() ) : 0.0;
+    m_Grid.assign( static_cast< size_t >( m_GridSize ) * m_GridSize, NO_TRIANGLE );
+    
+    std::vector< size_t > queue;
+    
+    for( i = 0; i < triangleCount; ++i ) {
+        Eigen::Vector2d center = ( m_Point[m_Index[3 * i]] + m_Point[m_Index[3 * i + 1]] + m_Point[m_Index[3 * i + 2]] ) / 3.0;
+        size_t cell = Jump( center );
+        
+        if( m_Grid[cell] == NO_TRIANGLE ) {
+            m_Grid[cell] = i;
+            queue.push_back( cell );
+        }
+    }
+    
+    // Empty cells take the triangle of the closest filled one, breadth first
+    for( size_t head = 0; head < queue.size(); ++head ) {
+        size_t cell = queue[head];
+        const int dx[4] = { 1, -1, 0, 0 }, dy[4] = { 0, 0, 1, -1 };
+        
+        x = cell % m_GridSize;
+        y = cell / m_GridSize;
+        
+        for( k = 0; k < 4; ++k ) {
+            if( ( dx[k] < 0 && x == 0 ) || ( dx[k] > 0 && x + 1 == m_GridSize ) || ( dy[k] < 0 && y == 0 ) || ( dy[k] > 0 && y + 1 == m_GridSize ) )
+                continue;
+            
+            size_t next = ( y + dy[k] ) * static_cast< size_t >( m_GridSize ) + ( x + dx[k] );
+            
+            if( m_Grid[next] == NO_TRIANGLE ) {
+                m_Grid[next] = m_Grid[cell];
+                queue.push_back( next );
+            }
+        }
+    }
+}
+
+// The grid cell of point, clamped to the grid. Build stores its triangle there.
+template< typename Scalar, typename Index, typename Predicate >
+Index DelaunayQuery< Scalar, Index, Predicate >::Jump( const Eigen::Vector2d& point ) const
+{
+    double x = ( point.x() - m_Min.x() ) * m_Scale.x();
+    double y = ( point.y() - m_Min.y() ) * m_Scale.y();
+    Index last = m_GridSize - 1;
+    Index ix = ( x > 0.0 ) ? std::min( static_cast< Index >( std::min( x, static_cast< double >( last ) ) ), last ) : 0;
+    Index iy = ( y > 0.0 ) ? std::min( static_cast< Index >( std::min( y, static_cast< double >( last ) ) ), last ) : 0;
+    
+    return iy * m_GridSize + ix;
+}
+
+// Visibility walk from the triangle of the grid cell, the edge to cross is tried from a
+// varying start so that the walk cannot cycle. False when it leaves the mesh at *pTriangle.
+template< typename Scalar, typename Index, typename Predicate >
+bool DelaunayQuery< Scalar, Index, Predicate >::Walk( const Eigen::Vector2d& point, Index *pTriangle ) const
+{
+    Index current = m_Grid[Jump( point )];
+    Index previous = NO_TRIANGLE;
+    Index seed = current;
+    int i, k, start;
+    bool moved;
+    
+    do {
+        const Index *index = &m_Index[3 * current];
+        const Index *neighbor = &m_Neighbor[3 * current];
+        
+        seed = seed * 1103515245ul + 12345ul;
+        start = static_cast< int >( ( seed >> 16 ) % 3 );
+        moved = false;
+        
+        for( k = 0; k < 3; ++k ) {
+            i = ( start + k ) % 3;
+            
+            if( neighbor[i] == previous && previous != NO_TRIANGLE )
+                continue;
+            
+            if( Predicate::Orientation( m_Point[index[( i + 1 ) % 3]], m_Point[index[( i + 2 ) % 3]], point ) < 0.0 ) {
+                if( neighbor[i] == NO_TRIANGLE ) {
+                    *pTriangle = current;
+                    return false;
+                }
+                
+                previous = current;
+                current = neighbor[i];
+                moved = true;
+                break;
+            }
+        }
+    } while( moved );
+    
+    *pTriangle = current;
+    
+    return true;
+}
+
+// Greedy descent on the Delaunay graph: a vertex with no neighbor closer to point is the closest of all
+template< typename Scalar, typename Index, typename Predicate >
+Index DelaunayQuery< Scalar, Index, Predicate >::Descend( const Eigen::Vector2d& point, Index triangle ) const
+{
+    Index vertex = m_Index[3 * triangle];
+    double distance = ( m_Point[vertex] - point ).squaredNorm();
+    Index start, current;
+    int i, turn;
+    bool moved;
+    
+    for( i = 1; i < 3; ++i ) {
+        double d = ( m_Point[m_Index[3 * triangle + i]] - point ).squaredNorm();
+        
+        if( d < distance ) {
+            distance = d;
+            vertex = m_Index[3 * triangle + i];
+        }
+    }
+    
+    do {
+        moved = false;
+        start = m_VertexLink[vertex];
+        
+        // Counterclockwise around the vertex, then clockwise from the start when the star is open
+        for( turn = 1; turn <= 2 && !moved; ++turn ) {
+            current = start;
+            
+            do {
+                for( i = 0; m_Index[3 * current + i] != vertex; ++i );
+                
+                // Both other corners, the last one of an open star is not the first of any triangle
+                for( int j = 1; j <= 2 && !moved; ++j ) {
+                    Index other = m_Index[3 * current + ( i + j ) % 3];
+                    double d = ( m_Point[other] - point ).squaredNorm();
+                    
+                    if( d < distance ) {
+                        distance = d;
+                        vertex = other;
+                        moved = true;
+                    }
+                }
+                
+                if( moved )
+                    break;
+                
+                current = m_Neighbor[3 * current + ( i + turn ) % 3];
+            } while( current != NO_TRIANGLE && current != start );
+            
+            if( current == start )
+                break;
+        }
+    } while( moved );
+    
+    return vertex;
+}
+
+template< typename Scalar, typename Index, typename Predicate >
+Index DelaunayQuery< Scalar, Index, Predicate >::Locate( const Point& point ) const
+{
+    Index triangle;
+    
+    if( m_Grid.empty() || !Walk( point.template cast< double >(), &triangle ) )
+        return NO_TRIANGLE;
+    
+    return triangle;
+}
+
+template< typename Scalar, typename Index, typename Predicate >
+void DelaunayQuery< Scalar, Index, Predicate >::Locate( const Scalar *pCoordinate, size_t count, Index *pTriangle, Scalar *pBarycentric ) const
+{
+    Run( count, [&]( size_t k ) {
+        const Eigen::Vector2d point( pCoordinate[2 * k], pCoordinate[2 * k + 1] );
+        Index triangle = NO_TRIANGLE;
+        
+        if( !m_Grid.empty() && !Walk( point, &triangle ) ) {
+            triangle = NO_TRIANGLE;
+        }
+        
+        pTriangle[k] = triangle;
+        
+        if( pBarycentric == NULL )
+            return;
+        
+        Scalar *weight = pBarycentric + 3 * k;
+        
+        if( triangle == NO_TRIANGLE ) {
+            weight[0] = weight[1] = weight[2] = 0;
+            return;
+        }
+        
+        const Eigen::Vector2d& a = m_Point[m_Index[3 * triangle]];
+        const Eigen::Vector2d& b = m_Point[m_Index[3 * triangle + 1]];
+        const Eigen::Vector2d& c = m_Point[m_Index[3 * triangle + 2]];
+        Eigen::Vector2d ab = b - a, ac = c - a, ap = point - a;
+        double area = ab.x() * ac.y() - ab.y() * ac.x();
+        double u = ( ap.x() * ac.y() - ap.y() * ac.x() ) / area;
+        double v = ( ab.x() * ap.y() - ab.y() * ap.x() ) / area;
+        
+        weight[0] = static_cast< Scalar >( 1.0 - u - v );
+        weight[1] = static_cast< Scalar >( u );
+        weight[2] = static_cast< Scalar >( v );
+    } );
+}
+
+template< typename Scalar, typename Index, typename Predicate >
+Index DelaunayQuery< Scalar, Index, Predicate >::Nearest( const Point& point ) const
+{
+    Index triangle;
+    
+    if( m_Grid.empty() )
+        return NO_TRIANGLE;
+    
+    Walk( point.template cast< double >(), &triangle );
+    
+    return Descend( point.template cast< double >(), triangle );
+}
+
+template< typename Scalar, typename Index, typename Predicate >
+void DelaunayQuery< Scalar, Index, Predicate >::Nearest( const Scalar *pCoordinate, size_t count, Index *pId ) const
+{
+    Run( count, [&]( size_t k ) {
+        const Eigen::Vector2d point( pCoordinate[2 * k], pCoordinate[2 * k + 1] );
+        Index triangle;
+        
+        if( m_Grid.empty() ) {
+            pId[k] = NO_TRIANGLE;
+            return;
+        }
+        
+        Walk( point, &triangle );
+        pId[k] = Descend( point, triangle );
+    } );
+}
+
+// Calls query( k ) for every k below count, the calling thread helps with the blocks
+template< typename Scalar, typename Index, typename Predicate >
+template< typename Query >
+void DelaunayQuery< Scalar, Index, Predicate >::Run( size_t count, Query query ) const
+{
+    std::atomic< size_t > next( 0 );
+    std::vector< std::thread > pool;
+    unsigned int threads = static_cast< unsigned int >( std::min< size_t >( m_ThreadCount, ( count + QUERY_BLOCK - 1 ) / QUERY_BLOCK ) );
+    
+    auto work = [&]() {
+        for( size_t begin = next.fetch_add( QUERY_BLOCK ); begin < count; begin = next.fetch_add( QUERY_BLOCK ) ) {
+            size_t end = std::min( begin + QUERY_BLOCK, count );
+            
+            for( size_t k = begin; k < end; ++k ) {
+                query( k );
+            }
+        }
+    };
+    
+    for( unsigned int k = 1; k < threads; ++k ) {
+        pool.push_back( std::thread( work ) );
+    }
+    
+    work();
+    
+    for( auto& thread : pool ) {
+        thread.join();
+    }
+}
+
+template class DelaunayQuery< double, uint32_t, ExactPredicate >;
+template class DelaunayQuery< double, uint64_t, ExactPredicate >;
+template class DelaunayQuery< float, uint32_t, ExactPredicate >;
+template class DelaunayQuery< double, uint32_t, FastPredicate >;
@@ -0,0 +1,71 @@
+/*************************************************
+ * Copyright (c) 2017 Toru Ito
+ * Released under the MIT license
+ * http://opensource.org/licenses/mit-license.php
+ *************************************************/
+
+#ifndef DelaunayQuery_hpp
+#define DelaunayQuery_hpp
+
+#include <stdio.h>
+#include <stddef.h>
+#include <vector>
+#include <Eigen/Core>
+#include <Eigen/Geometry>
+
+#include "Delaunay.hpp"
+
+// Point location and nearest point queries on a finished triangulation. Every query jumps to
+// the triangle stored in the grid cell it falls in, about two triangles per cell, and walks
+// from there, so it takes a few steps on evenly spread points. The nearest point is found by
+// descending the Delaunay graph from the closest corner of the triangle reached. Both rely on
+// a convex Delaunay mesh, that is one without segments or RemoveExterior.
+template< typename Scalar = double, typename Index = uint32_t, typename Predicate = ExactPredicate >
+class DelaunayQuery
+{
+public:
+    typedef typename Delaunay< Scalar, Index, Predicate >::Point Point;
+    
+    static const Index NO_TRIANGLE = static_cast< Index >( -1 );
+    
+public:
+    DelaunayQuery();
+    ~DelaunayQuery();
+    
+    // Copies the mesh, a changed triangulation needs another Build
+    void Build( const Delaunay< Scalar, Index, Predicate >& delaunay );
+    
+    // 0 uses every hardware thread
+    void SetThreadCount( unsigned int count );
+    
+    // Triangle in GetResult order around each of count points ( x, y pairs ), NO_TRIANGLE
+    // outside of the mesh. pBarycentric gets three weights per point for the corners of the
+    // triangle in GetResult order, or is NULL.
+    Index Locate( const Point& point ) const;
+    void Locate( const Scalar *pCoordinate, size_t count, Index *pTriangle, Scalar *pBarycentric = NULL ) const;
+    
+    // Id of the closest point of the mesh, NO_TRIANGLE when it has none
+    Index Nearest( const Point& point ) const;
+    void Nearest( const Scalar *pCoordinate, size_t count, Index *pId ) const;
+    
+private:
+    std::vector< Eigen::Vector2d >  m_Point;
+    std::vector< Index >            m_Index;
+    std::vector< Index >            m_Neighbor;
+    std::vector< Index >            m_VertexLink;
+    
+    std::vector< Index >            m_Grid;
+    Index                           m_GridSize;
+    Eigen::Vector2d                 m_Min;
+    Eigen::Vector2d                 m_Scale;
+    unsigned int                    m_ThreadCount;
+    
+    Index Jump( const Eigen::Vector2d& point ) const;
+    bool Walk( const Eigen::Vector2d& point, Index *pTriangle ) const;
+    Index Descend( const Eigen::Vector2d& point, Index triangle ) const;
+    
+    template< typename Query >
+    void Run( size_t count, Query query ) const;
+};
+
+#endif /* DelaunayQuery_hpp */
@@ -0,0 +1,438 @@
+/*************************************************
+ * Copyright (c) 2017 Toru Ito
+ * Released under the MIT license
+ * http://opensource.org/licenses/mit-license.php
+ *************************************************/
+
+#include "DelaunayRaster.hpp"
+#include <cmath>
+#include <atomic>
+#include <thread>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define RASTER_X86 1
+#endif
+
+// Rows per band, the unit of work of a thread
+static const size_t BAND_HEIGHT = 32;
+
+// Writes value + k * step to pRow[k] for k below count
+static void FillRowScalar( float *pRow, long begin, long count, double value, double step )
+{
+    for( long k = begin; k < count; ++k ) {
+        pRow[k] = static_cast< float >( value + k * step );
+    }
+}
+
+#ifdef RASTER_X86
+
+__attribute__(( target( "avx2" ) ))
+static long FillRowAVX2( float *pRow, long count, double value, double step )
+{
+    const __m256d base = _mm256_set1_pd( value );
+    const __m256d slope = _mm256_set1_pd( step );
+    const __m256d four = _mm256_set1_pd( 4.0 );
+    __m256d k = _mm256_set_pd( 3.0, 2.0, 1.0, 0.0 );
+    long i;
+    
+    for( i = 0; i + 4 <= count; i += 4 ) {
+        _mm_storeu_ps( pRow + i, _mm256_cvtpd_ps( _mm256_add_pd( base, _mm256_mul_pd( k, slope ) ) ) );
+        k = _mm256_add_pd( k, four );
+    }
+    
+    return i;
+}
+
+#endif
+
+static void FillRow( float *pRow, long count, double value, double step )
+{
+    long i = 0;
+    
+#ifdef RASTER_X86
+    if( Predicates::GetSimdLevel() >= Predicates::SIMD_AVX2 ) {
+        i = FillRowAVX2( pRow, count, value, step );
+    }
+#endif
+    
+    FillRowScalar( pRow, i, count, value, step );
+}
+
+template< typename Scalar, typename Index, typename Predicate >
+DelaunayRaster< Scalar, Index, Predicate >::DelaunayRaster()
+    :m_ThreadCount( 1 )
+{
+    SetThreadCount( 0 );
+}
+
+template< typename Scalar, typename Index, typename Predicate >
+DelaunayRaster< Scalar, Index, Predicate >::~DelaunayRaster()
+{
+}
+
+template< typename Scalar, typename Index, typename Predicate >
+void DelaunayRaster< Scalar, Index, Predicate >::SetThreadCount( unsigned int count )
+{
+    if( count == 0 ) {
+        count = std::thread::hardware_concurrency();
+    }
+    
+    m_ThreadCount = ( count > 0 ) ? count : 1;
+}
+
+template< typename Scalar, typename Index, typename Predicate >
+void DelaunayRaster< Scalar, Index, Predicate >::Build( const Delaunay< Scalar, Index, Predicate >& delaunay, const Scalar *pValue )
+{
+    Index triangleCount = delaunay.GetTriangleCount();
+    Index pointCount = delaunay.GetPointCount();
+    
+    m_Point.resize( pointCount );
+    m_Value.resize( pointCount );
+    m_Index.resize( 3 * triangleCount );
+    m_Neighbor.resize( 3 * triangleCount );
+    
+    for( Index i = 0; i < pointCount; ++i ) {
+        m_Point[i] = delaunay.GetPoint( i ).template cast< double >();
+        m_Value[i] = pValue[i];
+    }
+    
+    if( triangleCount > 0 ) {
+        delaunay.GetResult( &m_Index[0] );
+        delaunay.GetNeighbor( &m_Neighbor[0] );
+    }
+}
+
+template< typename Scalar, typename Index, typename Predicate >
+void DelaunayRaster< Scalar, Index, Predicate >::Render( Method method, const Point& origin, const Point& cellSize, size_t width, size_t height,
+                                                         float *pGrid, size_t stride, float noData ) const
+{
+    const Eigen::Vector2d corner = origin.template cast< double >();
+    const Eigen::Vector2d size = cellSize.template cast< double >();
+    const size_t bands = ( height + BAND_HEIGHT - 1 ) / BAND_HEIGHT;
+    
+    for( size_t row = 0; row < height; ++row ) {
+        std::fill( pGrid + row * stride, pGrid + row * stride + width, noData );
+    }
+    
+    if( m_Index.empty() || width == 0 || bands == 0 || size.x() == 0.0 || size.y() == 0.0 )
+        return;
+    
+    if( method == LINEAR ) {
+        // Every triangle goes to the bands its rows fall in
+        std::vector< std::vector< Index > > bin( bands );
+        
+        for( Index i = 0; i < m_Index.size(); i += 3 ) {
+            double low = std::min( m_Point[m_Index[i]].y(), std::min( m_Point[m_Index[i + 1]].y(), m_Point[m_Index[i + 2]].y() ) );
+            double high = std::max( m_Point[m_Index[i]].y(), std::max( m_Point[m_Index[i + 1]].y(), m_Point[m_Index[i + 2]].y() ) );
+            double first = ( low - corner.y() ) / size.y() - 0.5, last = ( high - corner.y() ) / size.y() - 0.5;
+            
+            if( first > last ) {
+                std::swap( first, last );
+            }
+            
+            first = std::max( std::ceil( first ), 0.0 );
+            last = std::min( std::floor( last ), static_cast< double >( height ) - 1.0 );
+            
+            if( first > last )
+                continue;
+            
+            for( double band = std::floor( first / BAND_HEIGHT ); band * BAND_HEIGHT <= last; band += 1.0 ) {
+                bin[static_cast< size_t >( band )].push_back( i / 3 );
+            }
+        }
+        
+        Run( bands, [&]( size_t band, unsigned int ) {
+            RenderLinear( bin[band], band * BAND_HEIGHT, std::min( ( band + 1 ) * BAND_HEIGHT, height ), corner, size, width, pGrid, stride );
+        } );
+    } else {
+        std::vector< Index > triangle( m_ThreadCount, 0 );
+        std::vector< Scratch > scratch( m_ThreadCount );
+        
+        Run( bands, [&]( size_t band, unsigned int thread ) {
+            RenderNatural( band * BAND_HEIGHT, std::min( ( band + 1 ) * BAND_HEIGHT, height ), corner, size, width, pGrid, stride, noData,
+                           &triangle[thread], &scratch[thread] );
+        } );
+    }
+}
+
+// The span of a triangle on a row lies between the two points where the row line crosses its edges
+template< typename Scalar, typename Index, typename Predicate >
+void DelaunayRaster< Scalar, Index, Predicate >::RenderLinear( const std::vector< Index >& triangles, size_t begin, size_t end, const Eigen::Vector2d& origin,
+                                                               const Eigen::Vector2d& cellSize, size_t width, float *pGrid, size_t stride ) const
+{
+    for( auto tri : triangles ) {
+        const Eigen::Vector2d& a = m_Point[m_Index[3 * tri]];
+        const Eigen::Vector2d& b = m_Point[m_Index[3 * tri + 1]];
+        const Eigen::Vector2d& c = m_Point[m_Index[3 * tri + 2]];
+        const Eigen::Vector2d ab = b - a, ac = c - a;
+        double area = ab.x() * ac.y() - ab.y() * ac.x();
+        
+        if( area == 0.0 )
+            continue;
+        
+        // The plane f( x, y ) = fa + gx * ( x - ax ) + gy * ( y - ay )
+        double fa = m_Value[m_Index[3 * tri]];
+        double fb = m_Value[m_Index[3 * tri + 1]] - fa, fc = m_Value[m_Index[3 * tri + 2]] - fa;
+        double gx = ( fb * ac.y() - fc * ab.y() ) / area;
+        double gy = ( fc * ab.x() - fb * ac.x() ) / area;
+        const Eigen::Vector2d *corner[3] = { &a, &b, &c };
+        
+        double low = std::min( a.y(), std::min( b.y(), c.y() ) ), high = std::max( a.y(), std::max( b.y(), c.y() ) );
+        double first = ( low - origin.y() ) / cellSize.y() - 0.5, last = ( high - origin.y() ) / cellSize.y() - 0.5;
+        
+        if( first > last ) {
+            std::swap( first, last );
+        }
+        
+        size_t rowBegin = static_cast< size_t >( std::max( std::ceil( first ), static_cast< double >( begin ) ) );
+        double rowLast = std::min( std::floor( last ), static_cast< double >( end ) - 1.0 );
+        
+        for( size_t row = rowBegin; static_cast< double >( row ) <= rowLast; ++row ) {
+            double y = origin.y() + ( row + 0.5 ) * cellSize.y();
+            double left = HUGE_VAL, right = -HUGE_VAL;
+            
+            for( int k = 0; k < 3; ++k ) {
+                const Eigen::Vector2d& p = *corner[k];
+                const Eigen::Vector2d& q = *corner[( k + 1 ) % 3];
+                
+                if( ( p.y() > y ) == ( q.y() > y ) && p.y() != y )
+                    continue;
+                
+                double x = ( p.y() == q.y() ) ? p.x() : p.x() + ( y - p.y() ) / ( q.y() - p.y() ) * ( q.x() - p.x() );
+                
+                if( p.y() == q.y() ) {
+                    left = std::min( left, std::min( p.x(), q.x() ) );
+                    right = std::max( right, std::max( p.x(), q.x() ) );
+                }
+                
+                left = std::min( left, x );
+                right = std::max( right, x );
+            }
+            
+            if( left > right )
+                continue;
+            
+            double from = ( left - origin.x() ) / cellSize.x() - 0.5, to = ( right - origin.x() ) / cellSize.x() - 0.5;
+            
+            if( from > to ) {
+                std::swap( from, to );
+            }
+            
+            from = std::max( std::ceil( from ), 0.0 );
+            to = std::min( std::floor( to ), static_cast< double >( width ) - 1.0 );
+            
+            if( from > to )
+                continue;
+            
+            double x = origin.x() + ( from + 0.5 ) * cellSize.x();
+            
+            FillRow( pGrid + row * stride + static_cast< size_t >( from ), static_cast< long >( to - from ) + 1,
+                     fa + gx * ( x - a.x() ) + gy * ( y - a.y() ), gx * cellSize.x() );
+        }
+    }
+}
+
+// Cell by cell, each walk starts from the triangle of the cell before
+template< typename Scalar, typename Index, typename Predicate >
+void DelaunayRaster< Scalar, Index, Predicate >::RenderNatural( size_t begin, size_t end, const Eigen::Vector2d& origin, const Eigen::Vector2d& cellSize,
+                                                                size_t width, float *pGrid, size_t stride, float noData, Index *pTriangle, Scratch *pScratch ) const
+{
+    for( size_t row = begin; row < end; ++row ) {
+        float *pRow = pGrid + row * stride;
+        
+        for( size_t column = 0; column < width; ++column ) {
+            const Eigen::Vector2d point( origin.x() + ( column + 0.5 ) * cellSize.x(), origin.y() + ( row + 0.5 ) * cellSize.y() );
+            
+            pRow[column] = Walk( point, pTriangle ) ? static_cast< float >( Natural( point, *pTriangle, pScratch ) ) : noData;
+        }
+    }
+}
+
+// Visibility walk as in Delaunay, false when it leaves the mesh, *pTriangle is then on the hull
+template< typename Scalar, typename Index, typename Predicate >
+bool DelaunayRaster< Scalar, Index, Predicate >::Walk( const Eigen::Vector2d& point, Index *pTriangle ) const
+{
+    const Index none = Delaunay< Scalar, Index, Predicate >::NO_NEIGHBOR;
+    Index current = *pTriangle;
+    Index previous = none;
+    Index seed = current;
+    int i, k, start;
+    bool moved;
+    
+    do {
+        const Index *index = &m_Index[3 * current];
+        const Index *neighbor = &m_Neighbor[3 * current];
+        
+        seed = seed * 1103515245ul + 12345ul;
+        start = static_cast< int >( ( seed >> 16 ) % 3 );
+        moved = false;
+        
+        for( k = 0; k < 3; ++k ) {
+            i = ( start + k ) % 3;
+            
+            if( neighbor[i] == previous && previous != none )
+                continue;
+            
+            if( Predicate::Orientation( m_Point[index[( i + 1 ) % 3]], m_Point[index[( i + 2 ) % 3]], point ) < 0.0 ) {
+                if( neighbor[i] == none ) {
+                    *pTriangle = current;
+                    return false;
+                }
+                
+                previous = current;
+                current = neighbor[i];
+                moved = true;
+                break;
+            }
+        }
+    } while( moved );
+    
+    *pTriangle = current;
+    
+    return true;
+}
+
+template< typename Scalar, typename Index, typename Predicate >
+double DelaunayRaster< Scalar, Index, Predicate >::Linear( const Eigen::Vector2d& point, Index triangle ) const
+{
+    const Eigen::Vector2d& a = m_Point[m_Index[3 * triangle]];
+    const Eigen::Vector2d ab = m_Point[m_Index[3 * triangle + 1]] - a, ac = m_Point[m_Index[3 * triangle + 2]] - a, ap = point - a;
+    double area = ab.x() * ac.y() - ab.y() * ac.x();
+    double u = ( ap.x() * ac.y() - ap.y() * ac.x() ) / area;
+    double v = ( ab.x() * ap.y() - ab.y() * ap.x() ) / area;
+    
+    return ( 1.0 - u - v ) * m_Value[m_Index[3 * triangle]] + u * m_Value[m_Index[3 * triangle + 1]] + v * m_Value[m_Index[3 * triangle + 2]];
+}
+
+// The triangles whose circumcircle holds the point form the cavity it would open. For every
+// vertex x on its boundary, with next and previous boundary vertices n and p, the area taken
+// from the cell of x is bounded by the circumcenters of ( x, n, point ), of the cavity
+// triangles around x from n over to p, and of ( p, x, point ).
+template< typename Scalar, typename Index, typename Predicate >
+double DelaunayRaster< Scalar, Index, Predicate >::Natural( const Eigen::Vector2d& point, Index triangle, Scratch *pScratch ) const
+{
+    const Index none = Delaunay< Scalar, Index, Predicate >::NO_NEIGHBOR;
+    std::vector< Index >& cavity = pScratch->cavity;
+    std::vector< Eigen::Vector2d >& center = pScratch->center;
+    std::vector< Index >& edge = pScratch->edge;
+    Index k, e, f, current, next;
+    int i, j;
+    
+    for( j = 0; j < 3; ++j ) {
+        if( m_Point[m_Index[3 * triangle + j]] == point )
+            return m_Value[m_Index[3 * triangle + j]];
+    }
+    
+    cavity.assign( 1, triangle );
+    edge.clear();
+    
+    // edge holds the boundary as ( from, to, triangle ) counterclockwise
+    for( k = 0; k < cavity.size(); ++k ) {
+        current = cavity[k];
+        
+        for( j = 0; j < 3; ++j ) {
+            next = m_Neighbor[3 * current + j];
+            
+            // An open cell has no area to weigh by
+            if( next == none )
+                return Linear( point, triangle );
+            
+            if( std::find( cavity.begin(), cavity.end(), next ) != cavity.end() )
+                continue;
+            
+            if( Predicate::InCircle( m_Point[m_Index[3 * next]], m_Point[m_Index[3 * next + 1]], m_Point[m_Index[3 * next + 2]], point ) > 0.0 ) {
+                cavity.push_back( next );
+            } else {
+                edge.push_back( m_Index[3 * current + ( j + 1 ) % 3] );
+                edge.push_back( m_Index[3 * current + ( j + 2 ) % 3] );
+                edge.push_back( current );
+            }
+        }
+    }
+    
+    center.resize( cavity.size() );
+    
+    for( k = 0; k < cavity.size(); ++k ) {
+        center[k] = Predicates::Circumcenter( m_Point[m_Index[3 * cavity[k]]], m_Point[m_Index[3 * cavity[k] + 1]], m_Point[m_Index[3 * cavity[k] + 2]] );
+    }
+    
+    double total = 0.0, sum = 0.0;
+    
+    for( e = 0; e < edge.size(); e += 3 ) {
+        Index vertex = edge[e], following = edge[e + 1], previous = none;
+        
+        for( f = 0; f < edge.size() && previous == none; f += 3 ) {
+            if( edge[f + 1] == vertex ) {
+                previous = edge[f];
+            }
+        }
+        
+        if( previous == none )
+            return Linear( point, triangle );
+        
+        Eigen::Vector2d first = Predicates::Circumcenter( m_Point[vertex], m_Point[following], point );
+        Eigen::Vector2d last = Predicates::Circumcenter( m_Point[previous], m_Point[vertex], point );
+        Eigen::Vector2d from = first;
+        double area = 0.0;
+        
+        // Counterclockwise around the vertex through the cavity
+        for( current = edge[e + 2]; ; current = m_Neighbor[3 * current + ( i + 1 ) % 3] ) {
+            for( i = 0; m_Index[3 * current + i] != vertex; ++i );
+            
+            k = std::find( cavity.begin(), cavity.end(), current ) - cavity.begin();
+            
+            if( k == cavity.size() )
+                return Linear( point, triangle );
+            
+            area += from.x() * center[k].y() - from.y() * center[k].x();
+            from = center[k];
+            
+            if( m_Index[3 * current + ( i + 2 ) % 3] == previous )
+                break;
+        }
+        
+        area += from.x() * last.y() - from.y() * last.x();
+        area += last.x() * first.y() - last.y() * first.x();
+        area = std::fabs( 0.5 * area );
+        
+        total += area;
+        sum += area * m_Value[vertex];
+    }
+    
+    if( !( total > 0.0 ) || !std::isfinite( sum ) )
+        return Linear( point, triangle );
+    
+    return sum / total;
+}
+
+// Calls band( k, thread ) for every band k below count, the calling thread is thread 0
+template< typename Scalar, typename Index, typename Predicate >
+template< typename Band >
+void DelaunayRaster< Scalar, Index, Predicate >::Run( size_t count, Band band ) const
+{
+    std::atomic< size_t > next( 0 );
+    std::vector< std::thread > pool;
+    unsigned int threads = static_cast< unsigned int >( std::min< size_t >( m_ThreadCount, count ) );
+    
+    auto work = [&]( unsigned int thread ) {
+        for( size_t k = next++; k < count; k = next++ ) {
+            band( k, thread );
+        }
+    };
+    
+    for( unsigned int k = 1; k < threads; ++k ) {
+        pool.push_back( std::thread( work, k ) );
+    }
+    
+    work( 0 );
+    
+    for( auto& thread : pool ) {
+        thread.join();
+    }
+}
+
+template class DelaunayRaster< double, uint32_t, ExactPredicate >;
+template class DelaunayRaster< double, uint64_t, ExactPredicate >;
+template class DelaunayRaster< float, uint32_t, ExactPredicate >;
+template class DelaunayRaster< double, uint32_t, FastPredicate >;
@@ -0,0 +1,80 @@
+/*************************************************
+ * Copyright (c) 2017 Toru Ito
+ * Released under the MIT license
+ * http://opensource.org/licenses/mit-license.php
+ *************************************************/
+
+#ifndef DelaunayRaster_hpp
+#define DelaunayRaster_hpp
+
+#include <stdio.h>
+#include <stddef.h>
+#include <vector>
+#include <Eigen/Core>
+#include <Eigen/Geometry>
+
+#include "Delaunay.hpp"
+
+// Interpolates values given at the points of a triangulation onto a regular grid, as for a
+// digital elevation model. The grid is rendered in bands of rows spread over the threads.
+//
+// LINEAR scans every triangle row by row and fills its span with the plane through the
+// corners, several cells per instruction where AVX2 is available. NATURAL_NEIGHBOR weighs the
+// natural neighbors of each cell center by the area its Voronoi cell would take from theirs
+// ( Sibson ), near the hull where that area is unbounded it falls back to LINEAR.
+template< typename Scalar = double, typename Index = uint32_t, typename Predicate = ExactPredicate >
+class DelaunayRaster
+{
+public:
+    typedef typename Delaunay< Scalar, Index, Predicate >::Point Point;
+    
+    enum Method
+    {
+        LINEAR,
+        NATURAL_NEIGHBOR
+    };
+    
+public:
+    DelaunayRaster();
+    ~DelaunayRaster();
+    
+    // Copies the mesh and one value per point id, a changed triangulation needs another Build
+    void Build( const Delaunay< Scalar, Index, Predicate >& delaunay, const Scalar *pValue );
+    
+    // 0 uses every hardware thread
+    void SetThreadCount( unsigned int count );
+    
+    // Cell ( column, row ) is pGrid[row * stride + column] and has its center at
+    // origin + ( column + 0.5, row + 0.5 ) * cellSize, per axis. A negative cell height puts
+    // row 0 at the top. Cells outside of the mesh get noData.
+    void Render( Method method, const Point& origin, const Point& cellSize, size_t width, size_t height,
+                 float *pGrid, size_t stride, float noData ) const;
+    
+private:
+    struct Scratch
+    {
+        std::vector< Index >            cavity;
+        std::vector< Eigen::Vector2d >  center;
+        std::vector< Index >            edge;
+    };
+    
+    std::vector< Eigen::Vector2d >  m_Point;
+    std::vector< double >           m_Value;
+    std::vector< Index >            m_Index;
+    std::vector< Index >            m_Neighbor;
+    unsigned int                    m_ThreadCount;
+    
+    void RenderLinear( const std::vector< Index >& triangles, size_t begin, size_t end, const Eigen::Vector2d& origin,
+                       const Eigen::Vector2d& cellSize, size_t width, float *pGrid, size_t stride ) const;
+    void RenderNatural( size_t begin, size_t end, const Eigen::Vector2d& origin, const Eigen::Vector2d& cellSize,
+                        size_t width, float *pGrid, size_t stride, float noData, Index *pTriangle, Scratch *pScratch ) const;
+    
+    bool Walk( const Eigen::Vector2d& point, Index *pTriangle ) const;
+    double Linear( const Eigen::Vector2d& point, Index triangle ) const;
+    double Natural( const Eigen::Vector2d& point, Index triangle, Scratch *pScratch ) const;
+    
+    template< typename Band >
+    void Run( size_t count, Band band ) const;
+};
+
+#endif /* DelaunayRaster_hpp */
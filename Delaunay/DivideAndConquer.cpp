@@ -0,0 +1,365 @@
+/*************************************************
+ * Copyright (c) 2017 Toru Ito
+ * Released under the MIT license
+ * http://opensource.org/licenses/mit-license.php
+ *************************************************/
+
+#include "DivideAndConquer.hpp"
+#include "Predicates.hpp"
+#include <algorithm>
+#include <thread>
+
+static const unsigned long MIN_PARALLEL_SIZE = 4096;
+
+template< typename Scalar, typename Index, typename Predicate >
+const Index DivideAndConquer< Scalar, Index, Predicate >::NO_EDGE;
+
+template< typename Scalar, typename Index, typename Predicate >
+DivideAndConquer< Scalar, Index, Predicate >::DivideAndConquer()
+    :m_pPoints( NULL )
+{
+}
+
+template< typename Scalar, typename Index, typename Predicate >
+DivideAndConquer< Scalar, Index, Predicate >::~DivideAndConquer()
+{
+}
+
+template< typename Scalar, typename Index, typename Predicate >
+void DivideAndConquer< Scalar, Index, Predicate >::Triangulation( const std::vector< Point >& points, std::vector< TriangleData > *pTriangles, unsigned int threadCount )
+{
+    pTriangles->clear();
+    
+    m_pPoints = &points;
+    m_SortIndex.resize( points.size() );
+    
+    for( Index i = 0; i < points.size(); ++i ) {
+        m_SortIndex[i] = i;
+    }
+    
+    unsigned int depth = 0;
+    
+    while( ( 1u << depth ) < threadCount ) {
+        ++depth;
+    }
+    
+    SortPoint( 0, m_SortIndex.size(), depth );
+    
+    // Coincident points would create zero-length edges, only the lowest index is kept
+    m_SortIndex.erase( std::unique( m_SortIndex.begin(), m_SortIndex.end(), [&points]( Index a, Index b ) {
+        return points[a] == points[b];
+    }), m_SortIndex.end() );
+    
+    if( m_SortIndex.size() < 3 )
+        return;
+    
+    // A planar graph on n vertices has at most 3n edges, which bounds every strip's block
+    m_Next.assign( 4 * 3 * m_SortIndex.size(), 0 );
+    m_Origin.assign( 4 * 3 * m_SortIndex.size(), NO_EDGE );
+    
+    EdgePool pool;
+    pool.next = 0;
+    pool.end = m_Next.size();
+    
+    Index left, right;
+    Divide( &pool, 0, m_SortIndex.size(), depth, &left, &right );
+    
+    ExtractTriangle( pTriangles );
+}
+
+template< typename Scalar, typename Index, typename Predicate >
+void DivideAndConquer< Scalar, Index, Predicate >::SortPoint( Index begin, Index end, unsigned int depth )
+{
+    const std::vector< Point >& points = *m_pPoints;
+    auto compare = [&points]( Index a, Index b ) {
+        if( points[a].x() != points[b].x() )
+            return points[a].x() < points[b].x();
+        if( points[a].y() != points[b].y() )
+            return points[a].y() < points[b].y();
+        return a < b;
+    };
+    
+    if( depth == 0 || end - begin < MIN_PARALLEL_SIZE ) {
+        std::sort( m_SortIndex.begin() + begin, m_SortIndex.begin() + end, compare );
+        return;
+    }
+    
+    Index middle = begin + ( end - begin ) / 2;
+    std::thread worker( &DivideAndConquer::SortPoint, this, begin, middle, depth - 1 );
+    
+    SortPoint( middle, end, depth - 1 );
+    worker.join();
+    
+    std::inplace_merge( m_SortIndex.begin() + begin, m_SortIndex.begin() + middle, m_SortIndex.begin() + end, compare );
+}
+
+template< typename Scalar, typename Index, typename Predicate >
+Index DivideAndConquer< Scalar, Index, Predicate >::MakeEdge( EdgePool *pPool, Index org, Index dest )
+{
+    Index e;
+    
+    if( pPool->free.empty() ) {
+        e = pPool->next;
+        pPool->next += 4;
+    } else {
+        e = pPool->free.back();
+        pPool->free.pop_back();
+    }
+    
+    m_Next[e]     = e;
+    m_Next[e + 1] = e + 3;
+    m_Next[e + 2] = e + 2;
+    m_Next[e + 3] = e + 1;
+    
+    m_Origin[e]     = org;
+    m_Origin[e + 1] = NO_EDGE;
+    m_Origin[e + 2] = dest;
+    m_Origin[e + 3] = NO_EDGE;
+    
+    return e;
+}
+
+template< typename Scalar, typename Index, typename Predicate >
+void DivideAndConquer< Scalar, Index, Predicate >::JoinPool( EdgePool *pLeft, EdgePool *pRight )
+{
+    for( Index e = pLeft->next; e < pLeft->end; e += 4 ) {
+        pLeft->free.push_back( e );
+    }
+    
+    pLeft->free.insert( pLeft->free.end(), pRight->free.begin(), pRight->free.end() );
+    pLeft->next = pRight->next;
+    pLeft->end = pRight->end;
+}
+
+template< typename Scalar, typename Index, typename Predicate >
+void DivideAndConquer< Scalar, Index, Predicate >::Splice( Index a, Index b )
+{
+    Index alpha = Rot( m_Next[a] );
+    Index beta  = Rot( m_Next[b] );
+    
+    std::swap( m_Next[a], m_Next[b] );
+    std::swap( m_Next[alpha], m_Next[beta] );
+}
+
+template< typename Scalar, typename Index, typename Predicate >
+Index DivideAndConquer< Scalar, Index, Predicate >::Connect( EdgePool *pPool, Index a, Index b )
+{
+    Index e = MakeEdge( pPool, Dest( a ), Org( b ) );
+    
+    Splice( e, Lnext( a ) );
+    Splice( Sym( e ), b );
+    
+    return e;
+}
+
+template< typename Scalar, typename Index, typename Predicate >
+void DivideAndConquer< Scalar, Index, Predicate >::DeleteEdge( EdgePool *pPool, Index e )
+{
+    Splice( e, Oprev( e ) );
+    Splice( Sym( e ), Oprev( Sym( e ) ) );
+    
+    e &= ~static_cast< Index >( 3 );
+    m_Origin[e] = m_Origin[e + 2] = NO_EDGE;
+    pPool->free.push_back( e );
+}
+
+template< typename Scalar, typename Index, typename Predicate >
+bool DivideAndConquer< Scalar, Index, Predicate >::IsCCW( Index a, Index b, Index c ) const
+{
+    const std::vector< Point >& points = *m_pPoints;
+    
+    return Predicate::Orientation( ToDouble( points[a] ), ToDouble( points[b] ), ToDouble( points[c] ) ) > 0.0;
+}
+
+template< typename Scalar, typename Index, typename Predicate >
+bool DivideAndConquer< Scalar, Index, Predicate >::IsRightOf( Index point, Index e ) const
+{
+    return IsCCW( point, Dest( e ), Org( e ) );
+}
+
+template< typename Scalar, typename Index, typename Predicate >
+bool DivideAndConquer< Scalar, Index, Predicate >::IsLeftOf( Index point, Index e ) const
+{
+    return IsCCW( point, Org( e ), Dest( e ) );
+}
+
+template< typename Scalar, typename Index, typename Predicate >
+bool DivideAndConquer< Scalar, Index, Predicate >::IsInCircle( Index a, Index b, Index c, Index d ) const
+{
+    const std::vector< Point >& points = *m_pPoints;
+    
+    return Predicate::InCircle( ToDouble( points[a] ), ToDouble( points[b] ), ToDouble( points[c] ), ToDouble( points[d] ) ) > 0.0;
+}
+
+template< typename Scalar, typename Index, typename Predicate >
+void DivideAndConquer< Scalar, Index, Predicate >::Divide( EdgePool *pPool, Index begin, Index end, unsigned int depth, Index *pLeft, Index *pRight )
+{
+    Index size = end - begin;
+    
+    if( size == 2 ) {
+        Index a = MakeEdge( pPool, m_SortIndex[begin], m_SortIndex[begin + 1] );
+        *pLeft = a;
+        *pRight = Sym( a );
+        return;
+    }
+    
+    if( size == 3 ) {
+        Index s1 = m_SortIndex[begin];
+        Index s2 = m_SortIndex[begin + 1];
+        Index s3 = m_SortIndex[begin + 2];
+        Index a = MakeEdge( pPool, s1, s2 );
+        Index b = MakeEdge( pPool, s2, s3 );
+        
+        Splice( Sym( a ), b );
+        
+        if( IsCCW( s1, s2, s3 ) ) {
+            Connect( pPool, b, a );
+            *pLeft = a;
+            *pRight = Sym( b );
+        } else if( IsCCW( s1, s3, s2 ) ) {
+            Index c = Connect( pPool, b, a );
+            *pLeft = Sym( c );
+            *pRight = c;
+        } else {
+            *pLeft = a;
+            *pRight = Sym( b );
+        }
+        return;
+    }
+    
+    Index middle = begin + size / 2;
+    Index ldo, ldi, rdi, rdo;
+    
+    if( depth == 0 || size < MIN_PARALLEL_SIZE ) {
+        Divide( pPool, begin, middle, 0, &ldo, &ldi );
+        Divide( pPool, middle, end, 0, &rdi, &rdo );
+    } else {
+        EdgePool left, right;
+        left.next = 4 * 3 * begin;
+        left.end = right.next = 4 * 3 * middle;
+        right.end = 4 * 3 * end;
+        
+        std::thread worker( &DivideAndConquer::Divide, this, &left, begin, middle, depth - 1, &ldo, &ldi );
+        
+        Divide( &right, middle, end, depth - 1, &rdi, &rdo );
+        worker.join();
+        
+        JoinPool( &left, &right );
+        pPool->next = left.next;
+        pPool->end = left.end;
+        pPool->free.swap( left.free );
+    }
+    
+    Merge( pPool, ldo, ldi, rdi, rdo, pLeft, pRight );
+}
+
+template< typename Scalar, typename Index, typename Predicate >
+void DivideAndConquer< Scalar, Index, Predicate >::Merge( EdgePool *pPool, Index ldo, Index ldi, Index rdi, Index rdo, Index *pLeft, Index *pRight )
+{
+    // Lower common tangent of the two hulls
+    for( ;; ) {
+        if( IsLeftOf( Org( rdi ), ldi ) ) {
+            ldi = Lnext( ldi );
+        } else if( IsRightOf( Org( ldi ), rdi ) ) {
+            rdi = Rprev( rdi );
+        } else {
+            break;
+        }
+    }
+    
+    Index basel = Connect( pPool, Sym( rdi ), ldi );
+    
+    if( Org( ldi ) == Org( ldo ) )
+        ldo = Sym( basel );
+    
+    if( Org( rdi ) == Org( rdo ) )
+        rdo = basel;
+    
+    // Zip the seam upwards, deleting the edges that fail the in-circle test
+    for( ;; ) {
+        Index lcand = Onext( Sym( basel ) );
+        bool lvalid = IsRightOf( Dest( lcand ), basel );
+        
+        if( lvalid ) {
+            while( IsInCircle( Dest( basel ), Org( basel ), Dest( lcand ), Dest( Onext( lcand ) ) ) ) {
+                Index t = Onext( lcand );
+                DeleteEdge( pPool, lcand );
+                lcand = t;
+            }
+        }
+        
+        Index rcand = Oprev( basel );
+        bool rvalid = IsRightOf( Dest( rcand ), basel );
+        
+        if( rvalid ) {
+            while( IsInCircle( Dest( basel ), Org( basel ), Dest( rcand ), Dest( Oprev( rcand ) ) ) ) {
+                Index t = Oprev( rcand );
+                DeleteEdge( pPool, rcand );
+                rcand = t;
+            }
+        }
+        
+        if( !lvalid && !rvalid )
+            break;
+        
+        if( !lvalid || ( rvalid && IsInCircle( Dest( lcand ), Org( lcand ), Org( rcand ), Dest( rcand ) ) ) ) {
+            basel = Connect( pPool, rcand, Sym( basel ) );
+        } else {
+            basel = Connect( pPool, Sym( basel ), Sym( lcand ) );
+        }
+    }
+    
+    *pLeft = ldo;
+    *pRight = rdo;
+}
+
+template< typename Scalar, typename Index, typename Predicate >
+void DivideAndConquer< Scalar, Index, Predicate >::ExtractTriangle( std::vector< TriangleData > *pTriangles )
+{
+    std::vector< Index > face( m_Next.size(), NO_EDGE );
+    std::vector< Index > edges;
+    Index e, a, b, c;
+    int i;
+    
+    // Every primal edge gets the index of its left face, the outer face keeps NO_EDGE
+    for( e = 0; e < m_Next.size(); ++e ) {
+        if( ( e & 1 ) || m_Origin[e] == NO_EDGE || face[e] != NO_EDGE )
+            continue;
+        
+        a = e;
+        b = Lnext( a );
+        c = Lnext( b );
+        
+        if( Lnext( c ) != a || !IsCCW( Org( a ), Org( b ), Org( c ) ) ) {
+            for( Index k = Lnext( e ); k != e; k = Lnext( k ) ) {
+                face[k] = NO_EDGE - 1;
+            }
+            face[e] = NO_EDGE - 1;
+            continue;
+        }
+        
+        face[a] = face[b] = face[c] = pTriangles->size();
+        
+        TriangleData tri;
+        tri.index[0] = Org( a );
+        tri.index[1] = Org( b );
+        tri.index[2] = Org( c );
+        pTriangles->push_back( tri );
+        edges.push_back( a );
+    }
+    
+    for( auto &tri : *pTriangles ) {
+        a = edges[&tri - &pTriangles->front()];
+        
+        for( i = 0; i < 3; ++i ) {
+            b = face[Sym( a )];
+            tri.neighbor[( i + 2 ) % 3] = ( b < NO_EDGE - 1 ) ? b : Delaunay< Scalar, Index, Predicate >::NO_NEIGHBOR;
+            a = Lnext( a );
+        }
+    }
+}
+
+template class DivideAndConquer< double, uint32_t, ExactPredicate >;
+template class DivideAndConquer< double, uint64_t, ExactPredicate >;
+template class DivideAndConquer< float, uint32_t, ExactPredicate >;
+template class DivideAndConquer< double, uint32_t, FastPredicate >;
@@ -0,0 +1,85 @@
+/*************************************************
+ * Copyright (c) 2017 Toru Ito
+ * Released under the MIT license
+ * http://opensource.org/licenses/mit-license.php
+ *************************************************/
+
+#ifndef DivideAndConquer_hpp
+#define DivideAndConquer_hpp
+
+#include <stdio.h>
+#include <vector>
+#include <Eigen/Core>
+#include <Eigen/Geometry>
+
+#include "Delaunay.hpp"
+
+// Guibas-Stolfi divide-and-conquer triangulation on a quad-edge structure.
+// An edge reference is ( quad-edge index << 2 ) | rotation.
+//
+// The x-sorted points are split into vertical strips that are triangulated on
+// separate threads and stitched by the regular merge step, so the result is the
+// same as the serial one. Every strip owns a disjoint block of the edge arrays.
+template< typename Scalar, typename Index, typename Predicate >
+class DivideAndConquer
+{
+public:
+    typedef typename Delaunay< Scalar, Index, Predicate >::Point Point;
+    typedef typename Delaunay< Scalar, Index, Predicate >::TriangleData TriangleData;
+    
+    DivideAndConquer();
+    ~DivideAndConquer();
+    
+    void Triangulation( const std::vector< Point >& points, std::vector< TriangleData > *pTriangles, unsigned int threadCount = 1 );
+    
+private:
+    static const Index NO_EDGE = static_cast< Index >( -1 );
+    
+    struct EdgePool
+    {
+        Index next;
+        Index end;
+        std::vector< Index > free;
+    };
+    
+    const std::vector< Point > *m_pPoints;
+    std::vector< Index > m_SortIndex;
+    std::vector< Index > m_Next;
+    std::vector< Index > m_Origin;
+    
+    static Index Rot( Index e )    { return ( e & ~static_cast< Index >( 3 ) ) | ( ( e + 1 ) & 3 ); }
+    static Index Sym( Index e )    { return e ^ 2; }
+    static Index InvRot( Index e ) { return ( e & ~static_cast< Index >( 3 ) ) | ( ( e + 3 ) & 3 ); }
+    
+    Index Onext( Index e ) const   { return m_Next[e]; }
+    Index Oprev( Index e ) const   { return Rot( m_Next[Rot( e )] ); }
+    Index Lnext( Index e ) const   { return Rot( m_Next[InvRot( e )] ); }
+    Index Rprev( Index e ) const   { return m_Next[Sym( e )]; }
+    Index Org( Index e ) const     { return m_Origin[e]; }
+    Index Dest( Index e ) const    { return m_Origin[Sym( e )]; }
+    
+    Index MakeEdge( EdgePool *pPool, Index org, Index dest );
+    void Splice( Index a, Index b );
+    Index Connect( EdgePool *pPool, Index a, Index b );
+    void DeleteEdge( EdgePool *pPool, Index e );
+    
+    static void JoinPool( EdgePool *pLeft, EdgePool *pRight );
+    
+    bool IsCCW( Index a, Index b, Index c ) const;
+    bool IsRightOf( Index point, Index e ) const;
+    bool IsLeftOf( Index point, Index e ) const;
+    bool IsInCircle( Index a, Index b, Index c, Index d ) const;
+    
+    void SortPoint( Index begin, Index end, unsigned int depth );
+    void Divide( EdgePool *pPool, Index begin, Index end, unsigned int depth, Index *pLeft, Index *pRight );
+    void Merge( EdgePool *pPool, Index ldo, Index ldi, Index rdi, Index rdo, Index *pLeft, Index *pRight );
+    
+    void ExtractTriangle( std::vector< TriangleData > *pTriangles );
+    
+    static Eigen::Vector2d ToDouble( const Point& point )
+    {
+        return point.template cast< double >();
+    }
+};
+
+#endif /* DivideAndConquer_hpp */
@@ -0,0 +1,134 @@
+/*************************************************
+ * Copyright (c) 2017 Toru Ito
+ * Released under the MIT license
+ * http://opensource.org/licenses/mit-license.php
+ *************************************************/
+
+#include "MeshFile.hpp"
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+const char MeshFile::MAGIC[8] = { 'D', 'L', 'N', 'Y', 'M', 'E', 'S', 'H' };
+
+static uint64_t AlignOffset( uint64_t offset )
+{
+    return ( offset + 15 ) & ~static_cast< uint64_t >( 15 );
+}
+
+void MeshFile::InitHeader( Header *pHeader, uint32_t scalarSize, uint32_t indexSize, uint64_t pointCount, uint64_t triangleCount, bool neighbor )
+{
+    memset( pHeader, 0, sizeof( Header ) );
+    memcpy( pHeader->magic, MAGIC, sizeof( MAGIC ) );
+
+    pHeader->version = VERSION;
+    pHeader->flags = neighbor ? HAS_NEIGHBOR : 0;
+    pHeader->scalarSize = scalarSize;
+    pHeader->indexSize = indexSize;
+    pHeader->pointCount = pointCount;
+    pHeader->triangleCount = triangleCount;
+
+    pHeader->pointOffset = AlignOffset( sizeof( Header ) );
+    pHeader->indexOffset = AlignOffset( pHeader->pointOffset + 2 * scalarSize * pointCount );
+    pHeader->neighborOffset = neighbor ? AlignOffset( pHeader->indexOffset + 3 * indexSize * triangleCount ) : 0;
+}
+
+bool MeshFile::IsLittleEndian()
+{
+    const uint16_t value = 1;
+
+    return *reinterpret_cast< const unsigned char * >( &value ) == 1;
+}
+
+MeshFile::MeshFile()
+    :m_pData( NULL )
+    ,m_Size( 0 )
+    ,m_pHeader( NULL )
+{
+}
+
+MeshFile::~MeshFile()
+{
+    Close();
+}
+
+bool MeshFile::Open( const char *pFileName )
+{
+    Close();
+
+    // The views are used in place, which needs the file's byte order
+    if( !IsLittleEndian() )
+        return false;
+
+    int file = open( pFileName, O_RDONLY );
+
+    if( file < 0 )
+        return false;
+
+    struct stat status;
+
+    if( fstat( file, &status ) != 0 || static_cast< uint64_t >( status.st_size ) < sizeof( Header ) ) {
+        close( file );
+        return false;
+    }
+
+    void *pData = mmap( NULL, status.st_size, PROT_READ, MAP_SHARED, file, 0 );
+    close( file );
+
+    if( pData == MAP_FAILED )
+        return false;
+
+    m_pData = static_cast< const unsigned char * >( pData );
+    m_Size = status.st_size;
+    m_pHeader = reinterpret_cast< const Header * >( m_pData );
+
+    if( !Validate() ) {
+        Close();
+        return false;
+    }
+
+    return true;
+}
+
+void MeshFile::Close()
+{
+    if( m_pData != NULL ) {
+        munmap( const_cast< unsigned char * >( m_pData ), m_Size );
+    }
+
+    m_pData = NULL;
+    m_Size = 0;
+    m_pHeader = NULL;
+}
+
+// Every section has to lie inside the file, the sizes are checked before they are multiplied
+bool MeshFile::Validate() const
+{
+    const Header& header = *m_pHeader;
+
+    if( memcmp( header.magic, MAGIC, sizeof( MAGIC ) ) != 0 || header.version != VERSION )
+        return false;
+
+    if( ( header.scalarSize != 4 && header.scalarSize != 8 ) || ( header.indexSize != 4 && header.indexSize != 8 ) )
+        return false;
+
+    if( header.pointCount > m_Size / ( 2 * header.scalarSize ) || header.triangleCount > m_Size / ( 3 * header.indexSize ) )
+        return false;
+
+    uint64_t points = 2 * header.scalarSize * header.pointCount;
+    uint64_t triangles = 3 * header.indexSize * header.triangleCount;
+
+    if( header.pointOffset % 16 != 0 || header.pointOffset > m_Size || points > m_Size - header.pointOffset )
+        return false;
+
+    if( header.indexOffset % 16 != 0 || header.indexOffset > m_Size || triangles > m_Size - header.indexOffset )
+        return false;
+
+    if( ( header.flags & HAS_NEIGHBOR ) &&
+        ( header.neighborOffset % 16 != 0 || header.neighborOffset > m_Size || triangles > m_Size - header.neighborOffset ) )
+        return false;
+
+    return true;
+}
@@ -0,0 +1,92 @@
+/*************************************************
+ * Copyright (c) 2017 Toru Ito
+ * Released under the MIT license
+ * http://opensource.org/licenses/mit-license.php
+ *************************************************/
+
+#ifndef MeshFile_hpp
+#define MeshFile_hpp
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stddef.h>
+
+// Binary triangulation file, little-endian:
+//
+//   Header   64 bytes, see below
+//   points   pointCount * 2 coordinates of scalarSize bytes, in point id order
+//   index    triangleCount * 3 point ids of indexSize bytes, counterclockwise
+//   neighbor triangleCount * 3 triangle indices, neighbor[i] is opposite index[i] and
+//            all bits set where there is none, present when HAS_NEIGHBOR is set
+//
+// Every section starts on a 16 byte boundary. The reader maps the file read-only, so the
+// views point straight into the page cache and processes opening the same file share it.
+class MeshFile
+{
+public:
+    enum
+    {
+        VERSION = 1,
+        HAS_NEIGHBOR = 1
+    };
+
+    struct Header
+    {
+        char     magic[8];
+        uint32_t version;
+        uint32_t flags;
+        uint32_t scalarSize;
+        uint32_t indexSize;
+        uint64_t pointCount;
+        uint64_t triangleCount;
+        uint64_t pointOffset;
+        uint64_t indexOffset;
+        uint64_t neighborOffset;
+    };
+
+    static const char MAGIC[8];
+
+    static void InitHeader( Header *pHeader, uint32_t scalarSize, uint32_t indexSize, uint64_t pointCount, uint64_t triangleCount, bool neighbor );
+    static bool IsLittleEndian();
+
+public:
+    MeshFile();
+    ~MeshFile();
+
+    bool Open( const char *pFileName );
+    void Close();
+
+    bool IsOpen() const { return m_pHeader != NULL; }
+    bool HasNeighbor() const { return ( m_pHeader->flags & HAS_NEIGHBOR ) != 0; }
+
+    uint64_t GetPointCount() const { return m_pHeader->pointCount; }
+    uint64_t GetTriangleCount() const { return m_pHeader->triangleCount; }
+
+    // The views are NULL when the type does not match the stored width
+    template< typename Scalar >
+    const Scalar *GetPoint() const
+    {
+        return ( sizeof( Scalar ) == m_pHeader->scalarSize ) ? reinterpret_cast< const Scalar * >( m_pData + m_pHeader->pointOffset ) : NULL;
+    }
+
+    template< typename Index >
+    const Index *GetIndex() const
+    {
+        return ( sizeof( Index ) == m_pHeader->indexSize ) ? reinterpret_cast< const Index * >( m_pData + m_pHeader->indexOffset ) : NULL;
+    }
+
+    template< typename Index >
+    const Index *GetNeighbor() const
+    {
+        return ( HasNeighbor() && sizeof( Index ) == m_pHeader->indexSize ) ? reinterpret_cast< const Index * >( m_pData + m_pHeader->neighborOffset ) : NULL;
+    }
+
+private:
+    const unsigned char *m_pData;
+    size_t               m_Size;
+    const Header        *m_pHeader;
+
+    bool Validate() const;
+};
+
+#endif /* MeshFile_hpp */
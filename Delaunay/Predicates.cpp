@@ -0,0 +1,807 @@
+/*************************************************
+ * Copyright (c) 2017 Toru Ito
+ * Released under the MIT license
+ * http://opensource.org/licenses/mit-license.php
+ *************************************************/
+
+#include "Predicates.hpp"
+#include <cmath>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define PREDICATES_X86 1
+#endif
+
+// Fused multiply-add would break the error-free transformations below
+#if defined(__clang__)
+#pragma STDC FP_CONTRACT OFF
+#elif defined(__GNUC__)
+#pragma GCC optimize ("fp-contract=off")
+#endif
+
+static const double EPSILON = 1.1102230246251565e-16;
+static const double SPLITTER = 134217729.0;
+static const double ORIENTATION_BOUND = ( 3.0 + 16.0 * EPSILON ) * EPSILON;
+static const double INCIRCLE_BOUND = ( 10.0 + 96.0 * EPSILON ) * EPSILON;
+static const double ORIENTATION3D_BOUND = ( 7.0 + 56.0 * EPSILON ) * EPSILON;
+static const double INSPHERE_BOUND = ( 16.0 + 224.0 * EPSILON ) * EPSILON;
+
+// An expansion is a sum of non-overlapping doubles stored in increasing magnitude
+
+static inline void TwoSum( double a, double b, double *x, double *y )
+{
+    *x = a + b;
+    double bv = *x - a;
+    double av = *x - bv;
+    *y = ( a - av ) + ( b - bv );
+}
+
+static inline void TwoDiff( double a, double b, double *x, double *y )
+{
+    *x = a - b;
+    double bv = a - *x;
+    double av = *x + bv;
+    *y = ( a - av ) + ( bv - b );
+}
+
+static inline void Split( double a, double *hi, double *lo )
+{
+    double c = SPLITTER * a;
+    double abig = c - a;
+    *hi = c - abig;
+    *lo = a - *hi;
+}
+
+static inline void TwoProduct( double a, double b, double *x, double *y )
+{
+    double ahi, alo, bhi, blo;
+    
+    *x = a * b;
+    Split( a, &ahi, &alo );
+    Split( b, &bhi, &blo );
+    
+    double err1 = *x - ( ahi * bhi );
+    double err2 = err1 - ( alo * bhi );
+    double err3 = err2 - ( ahi * blo );
+    *y = ( alo * blo ) - err3;
+}
+
+static int ScaleExpansion( int elen, const double *e, double b, double *h )
+{
+    double Q, sum, hh, product1, product0;
+    int eindex, hindex;
+    
+    TwoProduct( e[0], b, &Q, &hh );
+    hindex = 0;
+    
+    if( hh != 0.0 ) {
+        h[hindex++] = hh;
+    }
+    
+    for( eindex = 1; eindex < elen; ++eindex ) {
+        TwoProduct( e[eindex], b, &product1, &product0 );
+        TwoSum( Q, product0, &sum, &hh );
+        
+        if( hh != 0.0 ) {
+            h[hindex++] = hh;
+        }
+        
+        TwoSum( product1, sum, &Q, &hh );
+        
+        if( hh != 0.0 ) {
+            h[hindex++] = hh;
+        }
+    }
+    
+    if( Q != 0.0 || hindex == 0 ) {
+        h[hindex++] = Q;
+    }
+    
+    return hindex;
+}
+
+static int SumExpansion( int elen, const double *e, int flen, const double *f, double *h )
+{
+    double Q, Qnew, hh, enow, fnow;
+    int eindex = 0, findex = 0, hindex = 0;
+    
+    enow = e[0];
+    fnow = f[0];
+    
+    if( ( fnow > enow ) == ( fnow > -enow ) ) {
+        Q = enow;
+        enow = ( ++eindex < elen ) ? e[eindex] : 0.0;
+    } else {
+        Q = fnow;
+        fnow = ( ++findex < flen ) ? f[findex] : 0.0;
+    }
+    
+    if( eindex < elen && findex < flen ) {
+        if( ( fnow > enow ) == ( fnow > -enow ) ) {
+            Qnew = enow + Q;
+            hh = Q - ( Qnew - enow );
+            enow = ( ++eindex < elen ) ? e[eindex] : 0.0;
+        } else {
+            Qnew = fnow + Q;
+            hh = Q - ( Qnew - fnow );
+            fnow = ( ++findex < flen ) ? f[findex] : 0.0;
+        }
+        
+        Q = Qnew;
+        
+        if( hh != 0.0 ) {
+            h[hindex++] = hh;
+        }
+        
+        while( eindex < elen && findex < flen ) {
+            if( ( fnow > enow ) == ( fnow > -enow ) ) {
+                TwoSum( Q, enow, &Qnew, &hh );
+                enow = ( ++eindex < elen ) ? e[eindex] : 0.0;
+            } else {
+                TwoSum( Q, fnow, &Qnew, &hh );
+                fnow = ( ++findex < flen ) ? f[findex] : 0.0;
+            }
+            
+            Q = Qnew;
+            
+            if( hh != 0.0 ) {
+                h[hindex++] = hh;
+            }
+        }
+    }
+    
+    while( eindex < elen ) {
+        TwoSum( Q, enow, &Qnew, &hh );
+        enow = ( ++eindex < elen ) ? e[eindex] : 0.0;
+        Q = Qnew;
+        
+        if( hh != 0.0 ) {
+            h[hindex++] = hh;
+        }
+    }
+    
+    while( findex < flen ) {
+        TwoSum( Q, fnow, &Qnew, &hh );
+        fnow = ( ++findex < flen ) ? f[findex] : 0.0;
+        Q = Qnew;
+        
+        if( hh != 0.0 ) {
+            h[hindex++] = hh;
+        }
+    }
+    
+    if( Q != 0.0 || hindex == 0 ) {
+        h[hindex++] = Q;
+    }
+    
+    return hindex;
+}
+
+// h must hold 2 * elen * flen values
+static int MultiplyExpansion( int elen, const double *e, int flen, const double *f, double *h )
+{
+    double scaled[32], sum[512];
+    int hlen, i;
+    
+    hlen = ScaleExpansion( elen, e, f[0], h );
+    
+    for( i = 1; i < flen; ++i ) {
+        int slen = ScaleExpansion( elen, e, f[i], scaled );
+        
+        for( int k = 0; k < hlen; ++k ) {
+            sum[k] = h[k];
+        }
+        
+        hlen = SumExpansion( hlen, sum, slen, scaled, h );
+    }
+    
+    return hlen;
+}
+
+static void NegateExpansion( int elen, double *e )
+{
+    for( int i = 0; i < elen; ++i ) {
+        e[i] = -e[i];
+    }
+}
+
+// The value of the sum is dominated by its largest, last component
+static double EstimateExpansion( int elen, const double *e )
+{
+    return e[elen - 1];
+}
+
+double Predicates::Orientation( const Eigen::Vector2d& a, const Eigen::Vector2d& b, const Eigen::Vector2d& c )
+{
+    double detleft = ( a.x() - c.x() ) * ( b.y() - c.y() );
+    double detright = ( a.y() - c.y() ) * ( b.x() - c.x() );
+    double det = detleft - detright;
+    double detsum;
+    
+    if( detleft > 0.0 ) {
+        if( detright <= 0.0 )
+            return det;
+        detsum = detleft + detright;
+    } else if( detleft < 0.0 ) {
+        if( detright >= 0.0 )
+            return det;
+        detsum = -detleft - detright;
+    } else {
+        return det;
+    }
+    
+    double errbound = ORIENTATION_BOUND * detsum;
+    
+    if( det >= errbound || -det >= errbound )
+        return det;
+    
+    return OrientationExact( a, b, c );
+}
+
+double Predicates::OrientationExact( const Eigen::Vector2d& a, const Eigen::Vector2d& b, const Eigen::Vector2d& c )
+{
+    double acx[2], acy[2], bcx[2], bcy[2];
+    double left[8], right[8], det[16];
+    int llen, rlen, dlen;
+    
+    TwoDiff( a.x(), c.x(), &acx[1], &acx[0] );
+    TwoDiff( a.y(), c.y(), &acy[1], &acy[0] );
+    TwoDiff( b.x(), c.x(), &bcx[1], &bcx[0] );
+    TwoDiff( b.y(), c.y(), &bcy[1], &bcy[0] );
+    
+    llen = MultiplyExpansion( 2, acx, 2, bcy, left );
+    rlen = MultiplyExpansion( 2, acy, 2, bcx, right );
+    NegateExpansion( rlen, right );
+    dlen = SumExpansion( llen, left, rlen, right, det );
+    
+    return EstimateExpansion( dlen, det );
+}
+
+double Predicates::InCircle( const Eigen::Vector2d& a, const Eigen::Vector2d& b, const Eigen::Vector2d& c, const Eigen::Vector2d& d )
+{
+    double adx = a.x() - d.x();
+    double bdx = b.x() - d.x();
+    double cdx = c.x() - d.x();
+    double ady = a.y() - d.y();
+    double bdy = b.y() - d.y();
+    double cdy = c.y() - d.y();
+    
+    double bdxcdy = bdx * cdy;
+    double cdxbdy = cdx * bdy;
+    double alift = adx * adx + ady * ady;
+    
+    double cdxady = cdx * ady;
+    double adxcdy = adx * cdy;
+    double blift = bdx * bdx + bdy * bdy;
+    
+    double adxbdy = adx * bdy;
+    double bdxady = bdx * ady;
+    double clift = cdx * cdx + cdy * cdy;
+    
+    double det = alift * ( bdxcdy - cdxbdy ) + blift * ( cdxady - adxcdy ) + clift * ( adxbdy - bdxady );
+    
+    double permanent = ( std::fabs( bdxcdy ) + std::fabs( cdxbdy ) ) * alift
+                     + ( std::fabs( cdxady ) + std::fabs( adxcdy ) ) * blift
+                     + ( std::fabs( adxbdy ) + std::fabs( bdxady ) ) * clift;
+    
+    double errbound = INCIRCLE_BOUND * permanent;
+    
+    if( det > errbound || -det > errbound )
+        return det;
+    
+    return InCircleExact( a, b, c, d );
+}
+
+double Predicates::InCircleExact( const Eigen::Vector2d& a, const Eigen::Vector2d& b, const Eigen::Vector2d& c, const Eigen::Vector2d& d )
+{
+    double adx[2], ady[2], bdx[2], bdy[2], cdx[2], cdy[2];
+    double t1[8], t2[8];
+    double bc[16], ca[16], ab[16];
+    double alift[16], blift[16], clift[16];
+    double adet[512], bdet[512], cdet[512], abdet[1024], det[1536];
+    int t1len, t2len, bclen, calen, ablen, alen, blen, clen;
+    int adetlen, bdetlen, cdetlen, abdetlen, detlen;
+    
+    TwoDiff( a.x(), d.x(), &adx[1], &adx[0] );
+    TwoDiff( a.y(), d.y(), &ady[1], &ady[0] );
+    TwoDiff( b.x(), d.x(), &bdx[1], &bdx[0] );
+    TwoDiff( b.y(), d.y(), &bdy[1], &bdy[0] );
+    TwoDiff( c.x(), d.x(), &cdx[1], &cdx[0] );
+    TwoDiff( c.y(), d.y(), &cdy[1], &cdy[0] );
+    
+    t1len = MultiplyExpansion( 2, bdx, 2, cdy, t1 );
+    t2len = MultiplyExpansion( 2, cdx, 2, bdy, t2 );
+    NegateExpansion( t2len, t2 );
+    bclen = SumExpansion( t1len, t1, t2len, t2, bc );
+    
+    t1len = MultiplyExpansion( 2, cdx, 2, ady, t1 );
+    t2len = MultiplyExpansion( 2, adx, 2, cdy, t2 );
+    NegateExpansion( t2len, t2 );
+    calen = SumExpansion( t1len, t1, t2len, t2, ca );
+    
+    t1len = MultiplyExpansion( 2, adx, 2, bdy, t1 );
+    t2len = MultiplyExpansion( 2, bdx, 2, ady, t2 );
+    NegateExpansion( t2len, t2 );
+    ablen = SumExpansion( t1len, t1, t2len, t2, ab );
+    
+    t1len = MultiplyExpansion( 2, adx, 2, adx, t1 );
+    t2len = MultiplyExpansion( 2, ady, 2, ady, t2 );
+    alen = SumExpansion( t1len, t1, t2len, t2, alift );
+    
+    t1len = MultiplyExpansion( 2, bdx, 2, bdx, t1 );
+    t2len = MultiplyExpansion( 2, bdy, 2, bdy, t2 );
+    blen = SumExpansion( t1len, t1, t2len, t2, blift );
+    
+    t1len = MultiplyExpansion( 2, cdx, 2, cdx, t1 );
+    t2len = MultiplyExpansion( 2, cdy, 2, cdy, t2 );
+    clen = SumExpansion( t1len, t1, t2len, t2, clift );
+    
+    adetlen = MultiplyExpansion( alen, alift, bclen, bc, adet );
+    bdetlen = MultiplyExpansion( blen, blift, calen, ca, bdet );
+    cdetlen = MultiplyExpansion( clen, clift, ablen, ab, cdet );
+    
+    abdetlen = SumExpansion( adetlen, adet, bdetlen, bdet, abdet );
+    detlen = SumExpansion( abdetlen, abdet, cdetlen, cdet, det );
+    
+    return EstimateExpansion( detlen, det );
+}
+
+Eigen::Vector2d Predicates::Circumcenter( const Eigen::Vector2d& a, const Eigen::Vector2d& b, const Eigen::Vector2d& c )
+{
+    Eigen::Vector2d ba = b - a;
+    Eigen::Vector2d ca = c - a;
+    
+    double denominator = 2.0 * ( ba.x() * ca.y() - ba.y() * ca.x() );
+    double blength = ba.squaredNorm();
+    double clength = ca.squaredNorm();
+    
+    return a + Eigen::Vector2d( ( ca.y() * blength - ba.y() * clength ) / denominator,
+                                ( ba.x() * clength - ca.x() * blength ) / denominator );
+}
+
+// The 3D determinants outgrow the fixed buffers above, their rare exact paths use vectors
+typedef std::vector< double > Expansion;
+
+static Expansion Difference( double a, double b )
+{
+    Expansion h( 2 );
+    
+    TwoDiff( a, b, &h[1], &h[0] );
+    
+    return h;
+}
+
+static Expansion Sum( const Expansion& e, const Expansion& f )
+{
+    Expansion h( e.size() + f.size() );
+    
+    h.resize( SumExpansion( e.size(), e.data(), f.size(), f.data(), h.data() ) );
+    
+    return h;
+}
+
+static Expansion Product( const Expansion& e, const Expansion& f )
+{
+    Expansion h( 2 * e.size() * f.size() ), scaled( 2 * e.size() ), sum;
+    int hlen = ScaleExpansion( e.size(), e.data(), f[0], h.data() );
+    
+    for( size_t i = 1; i < f.size(); ++i ) {
+        int slen = ScaleExpansion( e.size(), e.data(), f[i], scaled.data() );
+        
+        sum.assign( h.begin(), h.begin() + hlen );
+        hlen = SumExpansion( hlen, sum.data(), slen, scaled.data(), h.data() );
+    }
+    
+    h.resize( hlen );
+    
+    return h;
+}
+
+static Expansion Negate( Expansion e )
+{
+    NegateExpansion( e.size(), e.data() );
+    
+    return e;
+}
+
+// a * d - b * c
+static Expansion CrossProduct( const Expansion& a, const Expansion& b, const Expansion& c, const Expansion& d )
+{
+    return Sum( Product( a, d ), Negate( Product( b, c ) ) );
+}
+
+double Predicates::Orientation3D( const Eigen::Vector3d& a, const Eigen::Vector3d& b, const Eigen::Vector3d& c, const Eigen::Vector3d& d )
+{
+    double adx = a.x() - d.x();
+    double bdx = b.x() - d.x();
+    double cdx = c.x() - d.x();
+    double ady = a.y() - d.y();
+    double bdy = b.y() - d.y();
+    double cdy = c.y() - d.y();
+    double adz = a.z() - d.z();
+    double bdz = b.z() - d.z();
+    double cdz = c.z() - d.z();
+    
+    double bdxcdy = bdx * cdy;
+    double cdxbdy = cdx * bdy;
+    double cdxady = cdx * ady;
+    double adxcdy = adx * cdy;
+    double adxbdy = adx * bdy;
+    double bdxady = bdx * ady;
+    
+    double det = adz * ( bdxcdy - cdxbdy ) + bdz * ( cdxady - adxcdy ) + cdz * ( adxbdy - bdxady );
+    
+    double permanent = ( std::fabs( bdxcdy ) + std::fabs( cdxbdy ) ) * std::fabs( adz )
+                     + ( std::fabs( cdxady ) + std::fabs( adxcdy ) ) * std::fabs( bdz )
+                     + ( std::fabs( adxbdy ) + std::fabs( bdxady ) ) * std::fabs( cdz );
+    
+    double errbound = ORIENTATION3D_BOUND * permanent;
+    
+    if( det > errbound || -det > errbound )
+        return det;
+    
+    return Orientation3DExact( a, b, c, d );
+}
+
+double Predicates::Orientation3DExact( const Eigen::Vector3d& a, const Eigen::Vector3d& b, const Eigen::Vector3d& c, const Eigen::Vector3d& d )
+{
+    Expansion adx = Difference( a.x(), d.x() ), ady = Difference( a.y(), d.y() ), adz = Difference( a.z(), d.z() );
+    Expansion bdx = Difference( b.x(), d.x() ), bdy = Difference( b.y(), d.y() ), bdz = Difference( b.z(), d.z() );
+    Expansion cdx = Difference( c.x(), d.x() ), cdy = Difference( c.y(), d.y() ), cdz = Difference( c.z(), d.z() );
+    
+    Expansion det = Sum( Sum( Product( CrossProduct( bdx, cdx, bdy, cdy ), adz ),
+                              Product( CrossProduct( cdx, adx, cdy, ady ), bdz ) ),
+                              Product( CrossProduct( adx, bdx, ady, bdy ), cdz ) );
+    
+    return EstimateExpansion( det.size(), det.data() );
+}
+
+double Predicates::InSphere( const Eigen::Vector3d& a, const Eigen::Vector3d& b, const Eigen::Vector3d& c, const Eigen::Vector3d& d, const Eigen::Vector3d& e )
+{
+    double aex = a.x() - e.x(), aey = a.y() - e.y(), aez = a.z() - e.z();
+    double bex = b.x() - e.x(), bey = b.y() - e.y(), bez = b.z() - e.z();
+    double cex = c.x() - e.x(), cey = c.y() - e.y(), cez = c.z() - e.z();
+    double dex = d.x() - e.x(), dey = d.y() - e.y(), dez = d.z() - e.z();
+    
+    double aexbey = aex * bey, bexaey = bex * aey;
+    double bexcey = bex * cey, cexbey = cex * bey;
+    double cexdey = cex * dey, dexcey = dex * cey;
+    double dexaey = dex * aey, aexdey = aex * dey;
+    double aexcey = aex * cey, cexaey = cex * aey;
+    double bexdey = bex * dey, dexbey = dex * bey;
+    
+    double ab = aexbey - bexaey;
+    double bc = bexcey - cexbey;
+    double cd = cexdey - dexcey;
+    double da = dexaey - aexdey;
+    double ac = aexcey - cexaey;
+    double bd = bexdey - dexbey;
+    
+    double abc = aez * bc - bez * ac + cez * ab;
+    double bcd = bez * cd - cez * bd + dez * bc;
+    double cda = cez * da + dez * ac + aez * cd;
+    double dab = dez * ab + aez * bd + bez * da;
+    
+    double alift = aex * aex + aey * aey + aez * aez;
+    double blift = bex * bex + bey * bey + bez * bez;
+    double clift = cex * cex + cey * cey + cez * cez;
+    double dlift = dex * dex + dey * dey + dez * dez;
+    
+    double det = ( dlift * abc - clift * dab ) + ( blift * cda - alift * bcd );
+    
+    aez = std::fabs( aez );
+    bez = std::fabs( bez );
+    cez = std::fabs( cez );
+    dez = std::fabs( dez );
+    
+    double aexbeyplus = std::fabs( aexbey ) + std::fabs( bexaey );
+    double bexceyplus = std::fabs( bexcey ) + std::fabs( cexbey );
+    double cexdeyplus = std::fabs( cexdey ) + std::fabs( dexcey );
+    double dexaeyplus = std::fabs( dexaey ) + std::fabs( aexdey );
+    double aexceyplus = std::fabs( aexcey ) + std::fabs( cexaey );
+    double bexdeyplus = std::fabs( bexdey ) + std::fabs( dexbey );
+    
+    double permanent = ( cexdeyplus * bez + bexdeyplus * cez + bexceyplus * dez ) * alift
+                     + ( dexaeyplus * cez + aexceyplus * dez + cexdeyplus * aez ) * blift
+                     + ( aexbeyplus * dez + bexdeyplus * aez + dexaeyplus * bez ) * clift
+                     + ( bexceyplus * aez + aexceyplus * bez + aexbeyplus * cez ) * dlift;
+    
+    double errbound = INSPHERE_BOUND * permanent;
+    
+    if( det > errbound || -det > errbound )
+        return det;
+    
+    return InSphereExact( a, b, c, d, e );
+}
+
+double Predicates::InSphereExact( const Eigen::Vector3d& a, const Eigen::Vector3d& b, const Eigen::Vector3d& c, const Eigen::Vector3d& d, const Eigen::Vector3d& e )
+{
+    Expansion aex = Difference( a.x(), e.x() ), aey = Difference( a.y(), e.y() ), aez = Difference( a.z(), e.z() );
+    Expansion bex = Difference( b.x(), e.x() ), bey = Difference( b.y(), e.y() ), bez = Difference( b.z(), e.z() );
+    Expansion cex = Difference( c.x(), e.x() ), cey = Difference( c.y(), e.y() ), cez = Difference( c.z(), e.z() );
+    Expansion dex = Difference( d.x(), e.x() ), dey = Difference( d.y(), e.y() ), dez = Difference( d.z(), e.z() );
+    
+    Expansion ab = CrossProduct( aex, bex, aey, bey );
+    Expansion bc = CrossProduct( bex, cex, bey, cey );
+    Expansion cd = CrossProduct( cex, dex, cey, dey );
+    Expansion da = CrossProduct( dex, aex, dey, aey );
+    Expansion ac = CrossProduct( aex, cex, aey, cey );
+    Expansion bd = CrossProduct( bex, dex, bey, dey );
+    
+    Expansion abc = Sum( Sum( Product( bc, aez ), Negate( Product( ac, bez ) ) ), Product( ab, cez ) );
+    Expansion bcd = Sum( Sum( Product( cd, bez ), Negate( Product( bd, cez ) ) ), Product( bc, dez ) );
+    Expansion cda = Sum( Sum( Product( da, cez ), Product( ac, dez ) ), Product( cd, aez ) );
+    Expansion dab = Sum( Sum( Product( ab, dez ), Product( bd, aez ) ), Product( da, bez ) );
+    
+    Expansion alift = Sum( Sum( Product( aex, aex ), Product( aey, aey ) ), Product( aez, aez ) );
+    Expansion blift = Sum( Sum( Product( bex, bex ), Product( bey, bey ) ), Product( bez, bez ) );
+    Expansion clift = Sum( Sum( Product( cex, cex ), Product( cey, cey ) ), Product( cez, cez ) );
+    Expansion dlift = Sum( Sum( Product( dex, dex ), Product( dey, dey ) ), Product( dez, dez ) );
+    
+    Expansion det = Sum( Sum( Product( abc, dlift ), Negate( Product( dab, clift ) ) ),
+                         Sum( Product( cda, blift ), Negate( Product( bcd, alift ) ) ) );
+    
+    return EstimateExpansion( det.size(), det.data() );
+}
+
+// Filtered in-circle determinant of one lane, falling back to the exact path when uncertain
+static inline double InCircleLane( const Eigen::Vector2d& d, double ax, double ay, double bx, double by, double cx, double cy )
+{
+    return Predicates::InCircle( Eigen::Vector2d( ax, ay ), Eigen::Vector2d( bx, by ), Eigen::Vector2d( cx, cy ), d );
+}
+
+#ifdef PREDICATES_X86
+
+__attribute__(( target( "sse2" ) ))
+static unsigned long InCircleSSE2( const Eigen::Vector2d& d, unsigned long count,
+                                   const double *ax, const double *ay, const double *bx, const double *by,
+                                   const double *cx, const double *cy, double *pResult )
+{
+    const __m128d dx = _mm_set1_pd( d.x() );
+    const __m128d dy = _mm_set1_pd( d.y() );
+    const __m128d sign = _mm_set1_pd( -0.0 );
+    const __m128d bound = _mm_set1_pd( INCIRCLE_BOUND );
+    unsigned long i;
+    
+    for( i = 0; i + 2 <= count; i += 2 ) {
+        __m128d adx = _mm_sub_pd( _mm_loadu_pd( ax + i ), dx );
+        __m128d ady = _mm_sub_pd( _mm_loadu_pd( ay + i ), dy );
+        __m128d bdx = _mm_sub_pd( _mm_loadu_pd( bx + i ), dx );
+        __m128d bdy = _mm_sub_pd( _mm_loadu_pd( by + i ), dy );
+        __m128d cdx = _mm_sub_pd( _mm_loadu_pd( cx + i ), dx );
+        __m128d cdy = _mm_sub_pd( _mm_loadu_pd( cy + i ), dy );
+        
+        __m128d bdxcdy = _mm_mul_pd( bdx, cdy ), cdxbdy = _mm_mul_pd( cdx, bdy );
+        __m128d cdxady = _mm_mul_pd( cdx, ady ), adxcdy = _mm_mul_pd( adx, cdy );
+        __m128d adxbdy = _mm_mul_pd( adx, bdy ), bdxady = _mm_mul_pd( bdx, ady );
+        
+        __m128d alift = _mm_add_pd( _mm_mul_pd( adx, adx ), _mm_mul_pd( ady, ady ) );
+        __m128d blift = _mm_add_pd( _mm_mul_pd( bdx, bdx ), _mm_mul_pd( bdy, bdy ) );
+        __m128d clift = _mm_add_pd( _mm_mul_pd( cdx, cdx ), _mm_mul_pd( cdy, cdy ) );
+        
+        __m128d det = _mm_add_pd( _mm_add_pd( _mm_mul_pd( alift, _mm_sub_pd( bdxcdy, cdxbdy ) ),
+                                              _mm_mul_pd( blift, _mm_sub_pd( cdxady, adxcdy ) ) ),
+                                  _mm_mul_pd( clift, _mm_sub_pd( adxbdy, bdxady ) ) );
+        
+        __m128d permanent = _mm_add_pd( _mm_add_pd( _mm_mul_pd( _mm_add_pd( _mm_andnot_pd( sign, bdxcdy ), _mm_andnot_pd( sign, cdxbdy ) ), alift ),
+                                                    _mm_mul_pd( _mm_add_pd( _mm_andnot_pd( sign, cdxady ), _mm_andnot_pd( sign, adxcdy ) ), blift ) ),
+                                        _mm_mul_pd( _mm_add_pd( _mm_andnot_pd( sign, adxbdy ), _mm_andnot_pd( sign, bdxady ) ), clift ) );
+        
+        _mm_storeu_pd( pResult + i, det );
+        
+        int uncertain = _mm_movemask_pd( _mm_cmple_pd( _mm_andnot_pd( sign, det ), _mm_mul_pd( bound, permanent ) ) );
+        
+        for( int lane = 0; uncertain != 0; ++lane, uncertain >>= 1 ) {
+            if( uncertain & 1 ) {
+                pResult[i + lane] = InCircleLane( d, ax[i + lane], ay[i + lane], bx[i + lane], by[i + lane], cx[i + lane], cy[i + lane] );
+            }
+        }
+    }
+    
+    return i;
+}
+
+__attribute__(( target( "avx2" ) ))
+static unsigned long InCircleAVX2( const Eigen::Vector2d& d, unsigned long count,
+                                   const double *ax, const double *ay, const double *bx, const double *by,
+                                   const double *cx, const double *cy, double *pResult )
+{
+    const __m256d dx = _mm256_set1_pd( d.x() );
+    const __m256d dy = _mm256_set1_pd( d.y() );
+    const __m256d sign = _mm256_set1_pd( -0.0 );
+    const __m256d bound = _mm256_set1_pd( INCIRCLE_BOUND );
+    unsigned long i;
+    
+    for( i = 0; i + 4 <= count; i += 4 ) {
+        __m256d adx = _mm256_sub_pd( _mm256_loadu_pd( ax + i ), dx );
+        __m256d ady = _mm256_sub_pd( _mm256_loadu_pd( ay + i ), dy );
+        __m256d bdx = _mm256_sub_pd( _mm256_loadu_pd( bx + i ), dx );
+        __m256d bdy = _mm256_sub_pd( _mm256_loadu_pd( by + i ), dy );
+        __m256d cdx = _mm256_sub_pd( _mm256_loadu_pd( cx + i ), dx );
+        __m256d cdy = _mm256_sub_pd( _mm256_loadu_pd( cy + i ), dy );
+        
+        __m256d bdxcdy = _mm256_mul_pd( bdx, cdy ), cdxbdy = _mm256_mul_pd( cdx, bdy );
+        __m256d cdxady = _mm256_mul_pd( cdx, ady ), adxcdy = _mm256_mul_pd( adx, cdy );
+        __m256d adxbdy = _mm256_mul_pd( adx, bdy ), bdxady = _mm256_mul_pd( bdx, ady );
+        
+        __m256d alift = _mm256_add_pd( _mm256_mul_pd( adx, adx ), _mm256_mul_pd( ady, ady ) );
+        __m256d blift = _mm256_add_pd( _mm256_mul_pd( bdx, bdx ), _mm256_mul_pd( bdy, bdy ) );
+        __m256d clift = _mm256_add_pd( _mm256_mul_pd( cdx, cdx ), _mm256_mul_pd( cdy, cdy ) );
+        
+        __m256d det = _mm256_add_pd( _mm256_add_pd( _mm256_mul_pd( alift, _mm256_sub_pd( bdxcdy, cdxbdy ) ),
+                                                    _mm256_mul_pd( blift, _mm256_sub_pd( cdxady, adxcdy ) ) ),
+                                     _mm256_mul_pd( clift, _mm256_sub_pd( adxbdy, bdxady ) ) );
+        
+        __m256d permanent = _mm256_add_pd( _mm256_add_pd( _mm256_mul_pd( _mm256_add_pd( _mm256_andnot_pd( sign, bdxcdy ), _mm256_andnot_pd( sign, cdxbdy ) ), alift ),
+                                                          _mm256_mul_pd( _mm256_add_pd( _mm256_andnot_pd( sign, cdxady ), _mm256_andnot_pd( sign, adxcdy ) ), blift ) ),
+                                           _mm256_mul_pd( _mm256_add_pd( _mm256_andnot_pd( sign, adxbdy ), _mm256_andnot_pd( sign, bdxady ) ), clift ) );
+        
+        _mm256_storeu_pd( pResult + i, det );
+        
+        int uncertain = _mm256_movemask_pd( _mm256_cmp_pd( _mm256_andnot_pd( sign, det ), _mm256_mul_pd( bound, permanent ), _CMP_LE_OQ ) );
+        
+        for( int lane = 0; uncertain != 0; ++lane, uncertain >>= 1 ) {
+            if( uncertain & 1 ) {
+                pResult[i + lane] = InCircleLane( d, ax[i + lane], ay[i + lane], bx[i + lane], by[i + lane], cx[i + lane], cy[i + lane] );
+            }
+        }
+    }
+    
+    return i;
+}
+
+__attribute__(( target( "avx512f" ) ))
+static unsigned long InCircleAVX512( const Eigen::Vector2d& d, unsigned long count,
+                                     const double *ax, const double *ay, const double *bx, const double *by,
+                                     const double *cx, const double *cy, double *pResult )
+{
+    const __m512d dx = _mm512_set1_pd( d.x() );
+    const __m512d dy = _mm512_set1_pd( d.y() );
+    const __m512d bound = _mm512_set1_pd( INCIRCLE_BOUND );
+    unsigned long i;
+    
+    for( i = 0; i + 8 <= count; i += 8 ) {
+        __m512d adx = _mm512_sub_pd( _mm512_loadu_pd( ax + i ), dx );
+        __m512d ady = _mm512_sub_pd( _mm512_loadu_pd( ay + i ), dy );
+        __m512d bdx = _mm512_sub_pd( _mm512_loadu_pd( bx + i ), dx );
+        __m512d bdy = _mm512_sub_pd( _mm512_loadu_pd( by + i ), dy );
+        __m512d cdx = _mm512_sub_pd( _mm512_loadu_pd( cx + i ), dx );
+        __m512d cdy = _mm512_sub_pd( _mm512_loadu_pd( cy + i ), dy );
+        
+        __m512d bdxcdy = _mm512_mul_pd( bdx, cdy ), cdxbdy = _mm512_mul_pd( cdx, bdy );
+        __m512d cdxady = _mm512_mul_pd( cdx, ady ), adxcdy = _mm512_mul_pd( adx, cdy );
+        __m512d adxbdy = _mm512_mul_pd( adx, bdy ), bdxady = _mm512_mul_pd( bdx, ady );
+        
+        __m512d alift = _mm512_add_pd( _mm512_mul_pd( adx, adx ), _mm512_mul_pd( ady, ady ) );
+        __m512d blift = _mm512_add_pd( _mm512_mul_pd( bdx, bdx ), _mm512_mul_pd( bdy, bdy ) );
+        __m512d clift = _mm512_add_pd( _mm512_mul_pd( cdx, cdx ), _mm512_mul_pd( cdy, cdy ) );
+        
+        __m512d det = _mm512_add_pd( _mm512_add_pd( _mm512_mul_pd( alift, _mm512_sub_pd( bdxcdy, cdxbdy ) ),
+                                                    _mm512_mul_pd( blift, _mm512_sub_pd( cdxady, adxcdy ) ) ),
+                                     _mm512_mul_pd( clift, _mm512_sub_pd( adxbdy, bdxady ) ) );
+        
+        __m512d permanent = _mm512_add_pd( _mm512_add_pd( _mm512_mul_pd( _mm512_add_pd( _mm512_abs_pd( bdxcdy ), _mm512_abs_pd( cdxbdy ) ), alift ),
+                                                          _mm512_mul_pd( _mm512_add_pd( _mm512_abs_pd( cdxady ), _mm512_abs_pd( adxcdy ) ), blift ) ),
+                                           _mm512_mul_pd( _mm512_add_pd( _mm512_abs_pd( adxbdy ), _mm512_abs_pd( bdxady ) ), clift ) );
+        
+        _mm512_storeu_pd( pResult + i, det );
+        
+        int uncertain = _mm512_cmp_pd_mask( _mm512_abs_pd( det ), _mm512_mul_pd( bound, permanent ), _CMP_LE_OQ );
+        
+        for( int lane = 0; uncertain != 0; ++lane, uncertain >>= 1 ) {
+            if( uncertain & 1 ) {
+                pResult[i + lane] = InCircleLane( d, ax[i + lane], ay[i + lane], bx[i + lane], by[i + lane], cx[i + lane], cy[i + lane] );
+            }
+        }
+    }
+    
+    return i;
+}
+
+static Predicates::SimdLevel DetectSimdLevel()
+{
+    __builtin_cpu_init();
+    
+    if( __builtin_cpu_supports( "avx512f" ) )
+        return Predicates::SIMD_AVX512;
+    
+    if( __builtin_cpu_supports( "avx2" ) )
+        return Predicates::SIMD_AVX2;
+    
+    if( __builtin_cpu_supports( "sse2" ) )
+        return Predicates::SIMD_SSE2;
+    
+    return Predicates::SIMD_NONE;
+}
+
+#else
+
+static Predicates::SimdLevel DetectSimdLevel()
+{
+    return Predicates::SIMD_NONE;
+}
+
+#endif
+
+static const Predicates::SimdLevel SupportedSimdLevel = DetectSimdLevel();
+static Predicates::SimdLevel CurrentSimdLevel = SupportedSimdLevel;
+
+Predicates::SimdLevel Predicates::GetSimdLevel()
+{
+    return CurrentSimdLevel;
+}
+
+void Predicates::SetSimdLevel( SimdLevel level )
+{
+    CurrentSimdLevel = ( level < SupportedSimdLevel ) ? level : SupportedSimdLevel;
+}
+
+void Predicates::InCircleBatch( const Eigen::Vector2d& d, unsigned long count,
+                                const double *ax, const double *ay, const double *bx, const double *by,
+                                const double *cx, const double *cy, double *pResult )
+{
+    unsigned long i = 0;
+    
+#ifdef PREDICATES_X86
+    // Every level also handles the remainder left by the wider one before it
+    switch( CurrentSimdLevel ) {
+        case SIMD_AVX512:
+            i += InCircleAVX512( d, count - i, ax + i, ay + i, bx + i, by + i, cx + i, cy + i, pResult + i );
+            /* fall through */
+        case SIMD_AVX2:
+            i += InCircleAVX2( d, count - i, ax + i, ay + i, bx + i, by + i, cx + i, cy + i, pResult + i );
+            /* fall through */
+        case SIMD_SSE2:
+            i += InCircleSSE2( d, count - i, ax + i, ay + i, bx + i, by + i, cx + i, cy + i, pResult + i );
+            break;
+        default:
+            break;
+    }
+#endif
+    
+    for( ; i < count; ++i ) {
+        pResult[i] = InCircleLane( d, ax[i], ay[i], bx[i], by[i], cx[i], cy[i] );
+    }
+}
+
+double FastPredicate::Orientation( const Eigen::Vector2d& a, const Eigen::Vector2d& b, const Eigen::Vector2d& c )
+{
+    return ( a.x() - c.x() ) * ( b.y() - c.y() ) - ( a.y() - c.y() ) * ( b.x() - c.x() );
+}
+
+double FastPredicate::InCircle( const Eigen::Vector2d& a, const Eigen::Vector2d& b, const Eigen::Vector2d& c, const Eigen::Vector2d& d )
+{
+    Eigen::Vector2d ad = a - d;
+    Eigen::Vector2d bd = b - d;
+    Eigen::Vector2d cd = c - d;
+    
+    return ad.squaredNorm() * ( bd.x() * cd.y() - cd.x() * bd.y() )
+         + bd.squaredNorm() * ( cd.x() * ad.y() - ad.x() * cd.y() )
+         + cd.squaredNorm() * ( ad.x() * bd.y() - bd.x() * ad.y() );
+}
+
+void FastPredicate::InCircleBatch( const Eigen::Vector2d& d, unsigned long count,
+                                   const double *ax, const double *ay, const double *bx, const double *by,
+                                   const double *cx, const double *cy, double *pResult )
+{
+    for( unsigned long i = 0; i < count; ++i ) {
+        pResult[i] = InCircle( Eigen::Vector2d( ax[i], ay[i] ), Eigen::Vector2d( bx[i], by[i] ), Eigen::Vector2d( cx[i], cy[i] ), d );
+    }
+}
+
+double FastPredicate::Orientation3D( const Eigen::Vector3d& a, const Eigen::Vector3d& b, const Eigen::Vector3d& c, const Eigen::Vector3d& d )
+{
+    return ( a - d ).dot( ( b - d ).cross( c - d ) );
+}
+
+double FastPredicate::InSphere( const Eigen::Vector3d& a, const Eigen::Vector3d& b, const Eigen::Vector3d& c, const Eigen::Vector3d& d, const Eigen::Vector3d& e )
+{
+    Eigen::Vector3d ae = a - e;
+    Eigen::Vector3d be = b - e;
+    Eigen::Vector3d ce = c - e;
+    Eigen::Vector3d de = d - e;
+    
+    return de.squaredNorm() * ae.dot( be.cross( ce ) ) - ce.squaredNorm() * de.dot( ae.cross( be ) )
+         + be.squaredNorm() * ce.dot( de.cross( ae ) ) - ae.squaredNorm() * be.dot( ce.cross( de ) );
+}
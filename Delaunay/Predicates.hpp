@@ -0,0 +1,106 @@
+/*************************************************
+ * Copyright (c) 2017 Toru Ito
+ * Released under the MIT license
+ * http://opensource.org/licenses/mit-license.php
+ *************************************************/
+
+#ifndef Predicates_hpp
+#define Predicates_hpp
+
+#include <stdio.h>
+#include <Eigen/Core>
+#include <Eigen/Geometry>
+
+// Adaptive-precision geometric predicates after Shewchuk.
+// The determinant is evaluated in floating point first and recomputed with
+// exact expansion arithmetic only when it is smaller than the error bound,
+// so the sign of the result is always correct.
+class Predicates
+{
+public:
+    enum SimdLevel
+    {
+        SIMD_NONE,
+        SIMD_SSE2,
+        SIMD_AVX2,
+        SIMD_AVX512
+    };
+    
+
+    // Positive if a, b, c are in counterclockwise order, zero if collinear
+    static double Orientation( const Eigen::Vector2d& a, const Eigen::Vector2d& b, const Eigen::Vector2d& c );
+    
+    // Positive if d lies inside the circle through the counterclockwise a, b, c, zero if cocircular
+    static double InCircle( const Eigen::Vector2d& a, const Eigen::Vector2d& b, const Eigen::Vector2d& c, const Eigen::Vector2d& d );
+    
+    // Positive if d lies below the plane through a, b, c, that is on the side from which
+    // they appear clockwise, zero if coplanar
+    static double Orientation3D( const Eigen::Vector3d& a, const Eigen::Vector3d& b, const Eigen::Vector3d& c, const Eigen::Vector3d& d );
+    
+    // Positive if e lies inside the sphere through a, b, c, d with a positive Orientation3D, zero if cospherical
+    static double InSphere( const Eigen::Vector3d& a, const Eigen::Vector3d& b, const Eigen::Vector3d& c, const Eigen::Vector3d& d, const Eigen::Vector3d& e );
+    
+    // In-circle test of one point against count triangles given as structure-of-arrays
+    // coordinates, several candidates per instruction on the best supported SIMD level
+    static void InCircleBatch( const Eigen::Vector2d& d, unsigned long count,
+                               const double *ax, const double *ay, const double *bx, const double *by,
+                               const double *cx, const double *cy, double *pResult );
+    
+    // Detected once at startup, SetSimdLevel can only lower it
+    static SimdLevel GetSimdLevel();
+    static void SetSimdLevel( SimdLevel level );
+    
+    static Eigen::Vector2d Circumcenter( const Eigen::Vector2d& a, const Eigen::Vector2d& b, const Eigen::Vector2d& c );
+    
+private:
+    static double OrientationExact( const Eigen::Vector2d& a, const Eigen::Vector2d& b, const Eigen::Vector2d& c );
+    static double InCircleExact( const Eigen::Vector2d& a, const Eigen::Vector2d& b, const Eigen::Vector2d& c, const Eigen::Vector2d& d );
+    static double Orientation3DExact( const Eigen::Vector3d& a, const Eigen::Vector3d& b, const Eigen::Vector3d& c, const Eigen::Vector3d& d );
+    static double InSphereExact( const Eigen::Vector3d& a, const Eigen::Vector3d& b, const Eigen::Vector3d& c, const Eigen::Vector3d& d, const Eigen::Vector3d& e );
+};
+
+// Precision policies for the triangulation engines
+struct ExactPredicate
+{
+    static double Orientation( const Eigen::Vector2d& a, const Eigen::Vector2d& b, const Eigen::Vector2d& c )
+    {
+        return Predicates::Orientation( a, b, c );
+    }
+    
+    static double InCircle( const Eigen::Vector2d& a, const Eigen::Vector2d& b, const Eigen::Vector2d& c, const Eigen::Vector2d& d )
+    {
+        return Predicates::InCircle( a, b, c, d );
+    }
+    
+    static void InCircleBatch( const Eigen::Vector2d& d, unsigned long count,
+                               const double *ax, const double *ay, const double *bx, const double *by,
+                               const double *cx, const double *cy, double *pResult )
+    {
+        Predicates::InCircleBatch( d, count, ax, ay, bx, by, cx, cy, pResult );
+    }
+    
+    static double Orientation3D( const Eigen::Vector3d& a, const Eigen::Vector3d& b, const Eigen::Vector3d& c, const Eigen::Vector3d& d )
+    {
+        return Predicates::Orientation3D( a, b, c, d );
+    }
+    
+    static double InSphere( const Eigen::Vector3d& a, const Eigen::Vector3d& b, const Eigen::Vector3d& c, const Eigen::Vector3d& d, const Eigen::Vector3d& e )
+    {
+        return Predicates::InSphere( a, b, c, d, e );
+    }
+};
+
+// Plain floating-point determinants without the exact fallback. Faster, but the sign
+// may be wrong for nearly degenerate input.
+struct FastPredicate
+{
+    static double Orientation( const Eigen::Vector2d& a, const Eigen::Vector2d& b, const Eigen::Vector2d& c );
+    static double InCircle( const Eigen::Vector2d& a, const Eigen::Vector2d& b, const Eigen::Vector2d& c, const Eigen::Vector2d& d );
+    static void InCircleBatch( const Eigen::Vector2d& d, unsigned long count,
+                               const double *ax, const double *ay, const double *bx, const double *by,
+                               const double *cx, const double *cy, double *pResult );
+    static double Orientation3D( const Eigen::Vector3d& a, const Eigen::Vector3d& b, const Eigen::Vector3d& c, const Eigen::Vector3d& d );
+    static double InSphere( const Eigen::Vector3d& a, const Eigen::Vector3d& b, const Eigen::Vector3d& c, const Eigen::Vector3d& d, const Eigen::Vector3d& e );
+};
+
+#endif /* Predicates_hpp */
@@ -265,8 +265,8 @@ void ShaderProgram::SetDataMatrix( Eigen::Vector3f min, Eigen::Vector3f max, Eig
 
 void ShaderProgram::SetDataMatrix( ShapeData *data, Eigen::Vector3f trans )
 {
-    Eigen::Vector3f min = data->m_Vertex.colwise().minCoeff().cast<float>();
-    Eigen::Vector3f max = data->m_Vertex.colwise().maxCoeff().cast<float>();
+    Eigen::Vector3f min = data->m_Vertex.colwise().minCoeff();
+    Eigen::Vector3f max = data->m_Vertex.colwise().maxCoeff();
     
     Eigen::Vector3f offset = ( ( max - min ) * 0.5 + min ) * - 1.0;
     float scale = 1.5f / ( max - min ).maxCoeff();
@@ -287,8 +287,8 @@ void ShaderProgram::SetDataMatrix( std::vector< ShapeData > *datas, Eigen::Vecto
     size_t i;
     
     for( i = 0; i < datas->size(); ++i ) {
-        mins.row(i) = datas->at(i).m_Vertex.colwise().minCoeff();
-        maxs.row(i) = datas->at(i).m_Vertex.colwise().maxCoeff();
+        mins.row(i) = datas->at(i).m_Vertex.colwise().minCoeff().cast<double>();
+        maxs.row(i) = datas->at(i).m_Vertex.colwise().maxCoeff().cast<double>();
     }
         
     Eigen::Vector3f min = mins.colwise().minCoeff().cast<float>();
@@ -0,0 +1,64 @@
+/*************************************************
+ * Copyright (c) 2017 Toru Ito
+ * Released under the MIT license
+ * http://opensource.org/licenses/mit-license.php
+ *************************************************/
+
+#include "ShapeBuffer.hpp"
+
+ShapeBuffer::ShapeBuffer()
+{
+}
+
+ShapeBuffer::~ShapeBuffer()
+{
+}
+
+void ShapeBuffer::SetIndex( const unsigned int *pIndexBuffer, size_t rows, size_t cols )
+{
+    m_Index = Eigen::Map< const MatrixUInt >( pIndexBuffer, rows, cols );
+}
+
+void ShapeBuffer::SetVertex( const std::vector< Eigen::Vector2d >& list )
+{
+    m_Vertex.resize( list.size(), 3 );
+    
+    for( size_t i = 0; i < list.size(); ++i ) {
+        m_Vertex( i, 0 ) = static_cast< float >( list[i].x() );
+        m_Vertex( i, 1 ) = static_cast< float >( list[i].y() );
+        m_Vertex( i, 2 ) = 0.0f;
+    }
+}
+
+// Each polyline of n points gives n vertices and n - 1 segments, the sizes are counted first
+void ShapeBuffer::SetPolyline( std::vector< std::vector< std::vector< Eigen::Vector2d > > > *pPointList )
+{
+    size_t vertexCount = 0, segmentCount = 0, vertex = 0, segment = 0;
+    
+    for( const auto& group : *pPointList ) {
+        for( const auto& item : group ) {
+            vertexCount += item.size();
+            segmentCount += item.empty() ? 0 : item.size() - 1;
+        }
+    }
+    
+    m_Vertex.resize( vertexCount, 3 );
+    m_Index.resize( segmentCount, 2 );
+    
+    for( const auto& group : *pPointList ) {
+        for( const auto& item : group ) {
+            for( auto it = item.begin(); it != item.end(); ++it ) {
+                if( it != item.begin() ) {
+                    m_Index( segment, 0 ) = static_cast< uint32_t >( vertex - 1 );
+                    m_Index( segment, 1 ) = static_cast< uint32_t >( vertex );
+                    ++segment;
+                }
+                
+                m_Vertex( vertex, 0 ) = static_cast< float >( (*it).x() );
+                m_Vertex( vertex, 1 ) = static_cast< float >( (*it).y() );
+                m_Vertex( vertex, 2 ) = 0.0f;
+                ++vertex;
+            }
+        }
+    }
+}
@@ -0,0 +1,112 @@
+/*************************************************
+ * Copyright (c) 2017 Toru Ito
+ * Released under the MIT license
+ * http://opensource.org/licenses/mit-license.php
+ *************************************************/
+
+#ifndef ShapeBuffer_hpp
+#define ShapeBuffer_hpp
+
+#include <stdio.h>
+#include <stdint.h>
+#include <vector>
+#include <Eigen/Core>
+#include <Eigen/Geometry>
+
+#include "Delaunay.hpp"
+
+// The CPU side of ShapeData, without any OpenGL call. m_Vertex holds interleaved float x, y, z
+// per vertex and m_Index 32-bit vertex indices per primitive, both row-major, so data() can go
+// to glBufferData as it is.
+class ShapeBuffer
+{
+public:
+    typedef Eigen::Matrix< float, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor >    MatrixFloat;
+    typedef Eigen::Matrix< uint32_t, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor > MatrixUInt;
+
+public:
+    ShapeBuffer();
+    ~ShapeBuffer();
+    
+    void SetPolyline( std::vector< std::vector< std::vector< Eigen::Vector2d > > > *pPointList );
+    void SetVertex( const std::vector< Eigen::Vector2d >& list );
+    void SetIndex( const unsigned int *pIndexBuffer, size_t rows, size_t cols );
+    
+    // Every point of the triangulation as a vertex, at its id, and the triangles as rows of 3
+    template< typename Scalar, typename Index, typename Predicate >
+    void SetTriangle( const Delaunay< Scalar, Index, Predicate >& delaunay )
+    {
+        SetPoint( delaunay );
+        m_Index.resize( delaunay.GetTriangleCount(), 3 );
+        
+        uint32_t *pIndex = m_Index.data();
+        
+        delaunay.ForEachTriangle( [&pIndex]( Index id1, Index id2, Index id3 ) {
+            pIndex[0] = static_cast< uint32_t >( id1 );
+            pIndex[1] = static_cast< uint32_t >( id2 );
+            pIndex[2] = static_cast< uint32_t >( id3 );
+            pIndex += 3;
+        });
+    }
+    
+    // The edges as rows of 2, each once. An inner edge is taken from the triangle that sees it
+    // going up in id, a boundary edge has only one triangle and is taken from GetBoundary.
+    template< typename Scalar, typename Index, typename Predicate >
+    void SetWireframe( const Delaunay< Scalar, Index, Predicate >& delaunay )
+    {
+        std::vector< Index > boundary;
+        size_t k;
+        
+        SetPoint( delaunay );
+        delaunay.GetBoundary( &boundary );
+        
+        // Euler, E = ( 3F + B ) / 2 with B boundary edges
+        m_Index.resize( ( 3 * static_cast< size_t >( delaunay.GetTriangleCount() ) + boundary.size() / 2 ) / 2, 2 );
+        
+        uint32_t *pIndex = m_Index.data();
+        
+        delaunay.ForEachTriangle( [&pIndex]( Index id1, Index id2, Index id3 ) {
+            const Index edge[4] = { id1, id2, id3, id1 };
+            
+            for( int i = 0; i < 3; ++i ) {
+                if( edge[i] < edge[i + 1] ) {
+                    pIndex[0] = static_cast< uint32_t >( edge[i] );
+                    pIndex[1] = static_cast< uint32_t >( edge[i + 1] );
+                    pIndex += 2;
+                }
+            }
+        });
+        
+        for( k = 0; k < boundary.size(); k += 2 ) {
+            if( boundary[k] > boundary[k + 1] ) {
+                pIndex[0] = static_cast< uint32_t >( boundary[k] );
+                pIndex[1] = static_cast< uint32_t >( boundary[k + 1] );
+                pIndex += 2;
+            }
+        }
+    }
+    
+    MatrixFloat   m_Vertex;
+    MatrixUInt    m_Index;
+
+private:
+    template< typename Scalar, typename Index, typename Predicate >
+    void SetPoint( const Delaunay< Scalar, Index, Predicate >& delaunay )
+    {
+        Index count = delaunay.GetPointCount();
+        
+        m_Vertex.resize( count, 3 );
+        
+        float *pVertex = m_Vertex.data();
+        
+        for( Index id = 0; id < count; ++id ) {
+            const typename Delaunay< Scalar, Index, Predicate >::Point point = delaunay.GetPoint( id );
+            pVertex[0] = static_cast< float >( point.x() );
+            pVertex[1] = static_cast< float >( point.y() );
+            pVertex[2] = 0.0f;
+            pVertex += 3;
+        }
+    }
+};
+
+#endif /* ShapeBuffer_hpp */
@@ -14,23 +14,15 @@
 
 #include <OpenGL/gl3.h>
 
-class ShapeData
-{
-public:
-    typedef Eigen::Matrix< double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor >       MatrixDouble;
-    typedef Eigen::Matrix< unsigned int, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor > MatrixUInt;
+#include "ShapeBuffer.hpp"
 
+class ShapeData : public ShapeBuffer
+{
 public:
     ShapeData();
     ~ShapeData();
     
-    static void ConvertListToMatrix( std::vector< std::vector< double > >& list, MatrixDouble& matrix );
-    static void ConvertListToMatrix( std::vector< std::vector< unsigned int > >& list, MatrixUInt& matrix );
-    
     void SetPolyline( std::vector< std::vector< std::vector< Eigen::Vector2d > > > *pPointList );
-    void SetVertex( std::vector< std::vector< double > >& list );
-    void SetVertex( std::vector< Eigen::Vector2d >& list );
-    void SetIndex( std::vector< std::vector< unsigned int > >& list );
     
     void SetDrawMode( GLenum mode );
     
@@ -38,9 +30,6 @@ public:
     void Draw();
     void DeleteDraw();
     
-    MatrixDouble  m_Vertex;
-    MatrixUInt    m_Index;
-    
 private:
     GLuint m_VertexBufferObject;
     GLuint m_IndexBufferObject;
@@ -0,0 +1,129 @@
+/*************************************************
+ * Copyright (c) 2017 Toru Ito
+ * Released under the MIT license
+ * http://opensource.org/licenses/mit-license.php
+ *************************************************/
+
+#include "Statistics.hpp"
+
+// A long session keeps the first events, the totals keep counting
+static const size_t MAX_TRACE_EVENT = 1 << 20;
+
+Statistics::Statistics()
+{
+    Reset();
+}
+
+void Statistics::Reset()
+{
+    inCircleCount = 0;
+    triangleCreated = 0;
+    triangleDestroyed = 0;
+    
+    for( int k = 0; k < HISTOGRAM_SIZE; ++k ) {
+        cavitySize[k] = 0;
+        walkLength[k] = 0;
+    }
+    
+    for( int k = 0; k < PHASE_COUNT; ++k ) {
+        phaseTime[k] = 0.0;
+    }
+    
+    m_TraceEvent.clear();
+    m_Origin = std::chrono::steady_clock::now();
+}
+
+const char *Statistics::GetPhaseName( Phase phase )
+{
+    const char *name[] = { "SortPoint", "CreateInitTriangle", "Insertion", "DivideAndConquer", "InsertPoints",
+                           "RemovePoints", "InsertSegment", "Refine" };
+    
+    return ( phase < PHASE_COUNT ) ? name[phase] : "Unknown";
+}
+
+void Statistics::AddHistogram( unsigned long *pHistogram, unsigned long value )
+{
+    int k = 0;
+    
+    while( value > 1 && k < HISTOGRAM_SIZE - 1 ) {
+        value >>= 1;
+        ++k;
+    }
+    
+    ++pHistogram[k];
+}
+
+void Statistics::Print( FILE *pFile ) const
+{
+    int k;
+    
+    fprintf( pFile, "in-circle tests    %lu\n", inCircleCount );
+    fprintf( pFile, "triangles created  %lu\n", triangleCreated );
+    fprintf( pFile, "triangles removed  %lu\n", triangleDestroyed );
+    
+    for( k = 0; k < PHASE_COUNT; ++k ) {
+        if( phaseTime[k] > 0.0 ) {
+            fprintf( pFile, "%-18s %.6f s\n", GetPhaseName( static_cast< Phase >( k ) ), phaseTime[k] );
+        }
+    }
+    
+    fprintf( pFile, "%12s %14s %14s\n", "from", "cavity size", "walk length" );
+    
+    for( k = 0; k < HISTOGRAM_SIZE; ++k ) {
+        if( cavitySize[k] > 0 || walkLength[k] > 0 ) {
+            fprintf( pFile, "%12lu %14lu %14lu\n", ( k == 0 ) ? 0ul : 1ul << k, cavitySize[k], walkLength[k] );
+        }
+    }
+}
+
+bool Statistics::WriteTrace( const char *pFileName ) const
+{
+    FILE *pFile = fopen( pFileName, "w" );
+    double end = 0.0;
+    
+    if( pFile == NULL )
+        return false;
+    
+    fprintf( pFile, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[" );
+    
+    for( size_t k = 0; k < m_TraceEvent.size(); ++k ) {
+        const TraceEvent& event = m_TraceEvent[k];
+        
+        fprintf( pFile, "%s\n{\"name\":\"%s\",\"cat\":\"delaunay\",\"ph\":\"X\",\"pid\":1,\"tid\":1,\"ts\":%.3f,\"dur\":%.3f}",
+                 ( k > 0 ) ? "," : "", GetPhaseName( event.phase ), event.start, event.duration );
+        
+        if( event.start + event.duration > end ) {
+            end = event.start + event.duration;
+        }
+    }
+    
+    // The totals as one counter sample at the end of the trace
+    fprintf( pFile, "%s\n{\"name\":\"Delaunay\",\"cat\":\"delaunay\",\"ph\":\"C\",\"pid\":1,\"tid\":1,\"ts\":%.3f,"
+             "\"args\":{\"inCircle\":%lu,\"triangleCreated\":%lu,\"triangleDestroyed\":%lu}}\n]}\n",
+             m_TraceEvent.empty() ? "" : ",", end, inCircleCount, triangleCreated, triangleDestroyed );
+    
+    return fclose( pFile ) == 0;
+}
+
+Statistics::ScopedPhase::ScopedPhase( Statistics *pStatistics, Phase phase )
+    :m_pStatistics( pStatistics )
+    ,m_Phase( phase )
+    ,m_Start( std::chrono::steady_clock::now() )
+{
+}
+
+Statistics::ScopedPhase::~ScopedPhase()
+{
+    std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+    double duration = std::chrono::duration< double >( end - m_Start ).count();
+    
+    m_pStatistics->phaseTime[m_Phase] += duration;
+    
+    if( m_pStatistics->m_TraceEvent.size() < MAX_TRACE_EVENT ) {
+        TraceEvent event;
+        event.phase = m_Phase;
+        event.start = std::chrono::duration< double, std::micro >( m_Start - m_pStatistics->m_Origin ).count();
+        event.duration = duration * 1e6;
+        m_pStatistics->m_TraceEvent.push_back( event );
+    }
+}
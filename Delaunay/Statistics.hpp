@@ -0,0 +1,101 @@
+/*************************************************
+ * Copyright (c) 2017 Toru Ito
+ * Released under the MIT license
+ * http://opensource.org/licenses/mit-license.php
+ *************************************************/
+
+#ifndef Statistics_hpp
+#define Statistics_hpp
+
+#include <stdio.h>
+#include <vector>
+#include <chrono>
+
+// Counters, histograms and phase timers of a triangulation, collected only when the library
+// is built with DELAUNAY_STATS defined. Otherwise the macros below expand to nothing and
+// Delaunay carries no Statistics at all.
+class Statistics
+{
+public:
+    enum Phase
+    {
+        SORT_POINT,
+        CREATE_INIT_TRIANGLE,
+        INSERTION,
+        DIVIDE_AND_CONQUER,
+        INSERT_POINTS,
+        REMOVE_POINTS,
+        INSERT_SEGMENT,
+        REFINE,
+        PHASE_COUNT
+    };
+    
+    // Bucket k counts the values from 2^k to 2^(k+1) - 1, bucket 0 also counts 0
+    enum
+    {
+        HISTOGRAM_SIZE = 32
+    };
+    
+    unsigned long inCircleCount;
+    unsigned long triangleCreated;
+    unsigned long triangleDestroyed;
+    unsigned long cavitySize[HISTOGRAM_SIZE];
+    unsigned long walkLength[HISTOGRAM_SIZE];
+    double        phaseTime[PHASE_COUNT];
+    
+public:
+    Statistics();
+    
+    void Reset();
+    void Print( FILE *pFile ) const;
+    
+    // Chrome trace event JSON, for chrome://tracing or Perfetto
+    bool WriteTrace( const char *pFileName ) const;
+    
+    static const char *GetPhaseName( Phase phase );
+    static void AddHistogram( unsigned long *pHistogram, unsigned long value );
+    
+    class ScopedPhase
+    {
+    public:
+        ScopedPhase( Statistics *pStatistics, Phase phase );
+        ~ScopedPhase();
+        
+    private:
+        Statistics                            *m_pStatistics;
+        Phase                                  m_Phase;
+        std::chrono::steady_clock::time_point  m_Start;
+    };
+    
+private:
+    struct TraceEvent
+    {
+        Phase   phase;
+        double  start;
+        double  duration;
+    };
+    
+    std::vector< TraceEvent >              m_TraceEvent;
+    std::chrono::steady_clock::time_point  m_Origin;
+};
+
+#ifdef DELAUNAY_STATS
+#define DELAUNAY_STATS_COUNT( counter, value )      ( m_Statistics.counter += ( value ) )
+#define DELAUNAY_STATS_HISTOGRAM( histogram, value ) Statistics::AddHistogram( m_Statistics.histogram, ( value ) )
+#define DELAUNAY_STATS_PHASE( phase )               Statistics::ScopedPhase scopedPhase( &m_Statistics, Statistics::phase )
+#else
+#define DELAUNAY_STATS_COUNT( counter, value )
+#define DELAUNAY_STATS_HISTOGRAM( histogram, value )
+#define DELAUNAY_STATS_PHASE( phase )
+#endif
+
+// The member makes Delaunay a different class with DELAUNAY_STATS. It lives in an inline
+// namespace named after the setting, which is part of every symbol, so code built with the
+// other setting than the library fails to link instead of reading the wrong layout.
+#ifdef DELAUNAY_STATS
+#define DELAUNAY_STATS_NAMESPACE WithStatistics
+#else
+#define DELAUNAY_STATS_NAMESPACE WithoutStatistics
+#endif
+
+#endif /* Statistics_hpp */
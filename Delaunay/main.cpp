@@ -48,7 +48,6 @@ int main(int argc, const char * argv[]) {
     glEnable(GL_DEPTH_TEST);
     
     std::vector< Eigen::Vector2d > PointList;
-    std::vector< std::vector< unsigned int > > IndexList;
     
     double x, y;
     int k;
@@ -62,11 +61,10 @@ int main(int argc, const char * argv[]) {
         PointList.push_back( Eigen::Vector2d( x, y ) );
     }
     
-    Delaunay delaunay;
+    Delaunay<> delaunay;
     delaunay.SetPoint( &PointList );
     delaunay.Triangulation();
-    delaunay.GetResult( &PointList, &IndexList );
-
+    
     ShaderProgram triangleProgram, wireframeProgram;
     ShapeData triangle, wireframe;
     
@@ -74,8 +72,7 @@ int main(int argc, const char * argv[]) {
     if( !triangleProgram.InitProgram() )
         return -1;
     
-    triangle.SetIndex( IndexList );
-    triangle.SetVertex( PointList );
+    triangle.SetTriangle( delaunay );
     triangle.InitDraw();
     triangle.SetDrawMode( GL_TRIANGLES );
     
@@ -83,26 +80,10 @@ int main(int argc, const char * argv[]) {
     triangleProgram.SetDataMatrix( &triangle, Eigen::Vector3f( 0.0f, 0.0f, 0.0f ) );
     
     //wireframe
-    std::vector< std::vector< unsigned int > > WireframeIndexList;
-    std::vector< unsigned int > WireframeIndexs;
-    unsigned int i, j;
-    
-    WireframeIndexs.resize( 2 );
-    
-    for( auto indexs : IndexList ) {
-        for( i = 0; i < 3; ++i ) {
-            j = ( i + 1 ) % 3;
-            WireframeIndexs[0] = indexs[i];
-            WireframeIndexs[1] = indexs[j];
-            WireframeIndexList.push_back( WireframeIndexs );
-        }
-    }
-    
     if( !wireframeProgram.InitProgram() )
         return -1;
     
-    wireframe.SetIndex( WireframeIndexList );
-    wireframe.SetVertex( PointList );
+    wireframe.SetWireframe( delaunay );
     wireframe.InitDraw();
     wireframe.SetDrawMode( GL_LINES );
     
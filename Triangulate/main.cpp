@@ -0,0 +1,278 @@
+/*************************************************
+ * Copyright (c) 2017 Toru Ito
+ * Released under the MIT license
+ * http://opensource.org/licenses/mit-license.php
+ *************************************************/
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <Eigen/Core>
+#include <Eigen/Geometry>
+
+#include "../Delaunay/Delaunay.hpp"
+
+struct Option
+{
+    unsigned int               threads;
+    Delaunay<>::Engine         engine;
+    bool                       text;
+    bool                       neighbor;
+    double                     merge;
+    std::string                directory;
+    std::vector< std::string > files;
+};
+
+struct Report
+{
+    unsigned long  points;
+    unsigned long  triangles;
+    double         read_time;
+    double         triangulation_time;
+    double         write_time;
+    bool           success;
+};
+
+static double Seconds( std::chrono::steady_clock::time_point start )
+{
+    return std::chrono::duration< double >( std::chrono::steady_clock::now() - start ).count();
+}
+
+// Every line with two numbers is a point, separated by spaces, tabs or commas.
+// Anything else, such as a header or a # comment, is skipped.
+static bool ReadPoint( const char *pFileName, std::vector< double > *pCoordinate )
+{
+    FILE *pFile = fopen( pFileName, "rb" );
+    
+    if( pFile == NULL )
+        return false;
+    
+    std::vector< char > buffer;
+    char chunk[1 << 16];
+    size_t size;
+    
+    while( ( size = fread( chunk, 1, sizeof( chunk ), pFile ) ) > 0 ) {
+        buffer.insert( buffer.end(), chunk, chunk + size );
+    }
+    
+    bool success = ferror( pFile ) == 0;
+    fclose( pFile );
+    buffer.push_back( '\0' );
+    
+    pCoordinate->clear();
+    
+    for( char *pLine = buffer.data(); success && *pLine != '\0'; ) {
+        char *pEnd = pLine + strcspn( pLine, "\n" );
+        bool last = ( *pEnd == '\0' );
+        char *pNext;
+        double x, y;
+        
+        *pEnd = '\0';
+        
+        x = strtod( pLine, &pNext );
+        
+        if( pNext != pLine ) {
+            pLine = pNext + strspn( pNext, " \t," );
+            y = strtod( pLine, &pNext );
+            
+            if( pNext != pLine ) {
+                pCoordinate->push_back( x );
+                pCoordinate->push_back( y );
+            }
+        }
+        
+        if( last )
+            break;
+        
+        pLine = pEnd + 1;
+    }
+    
+    return success;
+}
+
+// One triangle per line as three zero-based point numbers of the input file
+static bool WriteText( const char *pFileName, const std::vector< uint32_t >& index )
+{
+    FILE *pFile = fopen( pFileName, "w" );
+    
+    if( pFile == NULL )
+        return false;
+    
+    bool success = true;
+    
+    for( size_t i = 0; i < index.size() && success; i += 3 ) {
+        success = fprintf( pFile, "%u %u %u\n", index[i], index[i + 1], index[i + 2] ) > 0;
+    }
+    
+    return ( fclose( pFile ) == 0 ) && success;
+}
+
+// The input name with the output extension, in the output directory if one is given
+static std::string OutputName( const Option& option, const std::string& input )
+{
+    std::string name = input;
+    size_t slash = name.find_last_of( '/' );
+    size_t dot = name.find_last_of( '.' );
+    
+    if( dot != std::string::npos && ( slash == std::string::npos || dot > slash ) ) {
+        name.erase( dot );
+    }
+    
+    if( !option.directory.empty() ) {
+        name = option.directory + "/" + ( ( slash == std::string::npos ) ? name : name.substr( slash + 1 ) );
+    }
+    
+    return name + ( option.text ? ".tri" : ".mesh" );
+}
+
+static Report Run( const Option& option, const std::string& input )
+{
+    Report report = Report();
+    std::vector< double > coordinate;
+    
+    auto start = std::chrono::steady_clock::now();
+    
+    if( !ReadPoint( input.c_str(), &coordinate ) )
+        return report;
+    
+    report.points = coordinate.size() / 2;
+    report.read_time = Seconds( start );
+    start = std::chrono::steady_clock::now();
+    
+    // The files already keep every thread busy, each triangulation runs on one
+    Delaunay<> delaunay( option.engine );
+    delaunay.SetMergeDistance( option.merge );
+    delaunay.SetPoint( coordinate.data(), report.points, 2, ( option.engine == Delaunay<>::BOWYER_WATSON ) ? Delaunay<>::BRIO_ORDER : Delaunay<>::INPUT_ORDER );
+    delaunay.Triangulation();
+    
+    report.triangles = delaunay.GetTriangleCount();
+    report.triangulation_time = Seconds( start );
+    start = std::chrono::steady_clock::now();
+    
+    std::string output = OutputName( option, input );
+    
+    if( option.text ) {
+        std::vector< uint32_t > index( 3 * report.triangles );
+        
+        if( report.triangles > 0 ) {
+            delaunay.GetResult( index.data() );
+        }
+        
+        report.success = WriteText( output.c_str(), index );
+    } else {
+        report.success = delaunay.Write( output.c_str(), option.neighbor );
+    }
+    
+    report.write_time = Seconds( start );
+    
+    return report;
+}
+
+static void Usage()
+{
+    fprintf( stderr,
+             "usage: DelaunayTriangulate [options] file...\n"
+             "  -j threads   files triangulated at once, all cores by default\n"
+             "  -e bw|dc     Bowyer-Watson with BRIO order or divide and conquer, bw by default\n"
+             "  -o directory where the results go, next to the inputs by default\n"
+             "  -t           write text, one triangle per line, instead of a mesh file\n"
+             "  -n           store the triangle adjacency in the mesh file\n"
+             "  -m distance  merge points closer than distance, exact duplicates only by default\n" );
+}
+
+static bool ParseOption( int argc, const char * argv[], Option *pOption )
+{
+    pOption->threads = std::max( std::thread::hardware_concurrency(), 1u );
+    pOption->engine = Delaunay<>::BOWYER_WATSON;
+    pOption->text = false;
+    pOption->neighbor = false;
+    pOption->merge = 0.0;
+    
+    for( int i = 1; i < argc; ++i ) {
+        const char *arg = argv[i];
+        
+        if( strcmp( arg, "-j" ) == 0 && i + 1 < argc ) {
+            pOption->threads = std::max( static_cast< unsigned int >( std::strtoul( argv[++i], NULL, 10 ) ), 1u );
+        } else if( strcmp( arg, "-e" ) == 0 && i + 1 < argc ) {
+            ++i;
+            
+            if( strcmp( argv[i], "bw" ) == 0 ) {
+                pOption->engine = Delaunay<>::BOWYER_WATSON;
+            } else if( strcmp( argv[i], "dc" ) == 0 ) {
+                pOption->engine = Delaunay<>::DIVIDE_AND_CONQUER;
+            } else {
+                return false;
+            }
+        } else if( strcmp( arg, "-o" ) == 0 && i + 1 < argc ) {
+            pOption->directory = argv[++i];
+        } else if( strcmp( arg, "-t" ) == 0 ) {
+            pOption->text = true;
+        } else if( strcmp( arg, "-n" ) == 0 ) {
+            pOption->neighbor = true;
+        } else if( strcmp( arg, "-m" ) == 0 && i + 1 < argc ) {
+            pOption->merge = std::strtod( argv[++i], NULL );
+        } else if( arg[0] == '-' ) {
+            return false;
+        } else {
+            pOption->files.push_back( arg );
+        }
+    }
+    
+    return !pOption->files.empty();
+}
+
+int main(int argc, const char * argv[]) {
+    
+    Option option;
+    
+    if( !ParseOption( argc, argv, &option ) ) {
+        Usage();
+        return 2;
+    }
+    
+    std::atomic< size_t > next( 0 );
+    std::atomic< unsigned long > failed( 0 );
+    std::mutex output;
+    std::vector< std::thread > pool;
+    unsigned int threads = std::min< size_t >( option.threads, option.files.size() );
+    
+    auto start = std::chrono::steady_clock::now();
+    
+    printf( "%10s %12s %12s %12s %12s  %s\n", "points", "triangles", "read [s]", "delaunay [s]", "write [s]", "file" );
+    
+    // The workers take the next file until none is left, so large and small files balance out
+    for( unsigned int k = 0; k < threads; ++k ) {
+        pool.push_back( std::thread( [&]() {
+            for( size_t i = next++; i < option.files.size(); i = next++ ) {
+                Report report = Run( option, option.files[i] );
+                std::lock_guard< std::mutex > lock( output );
+                
+                if( report.success ) {
+                    printf( "%10lu %12lu %12.4f %12.4f %12.4f  %s\n", report.points, report.triangles,
+                            report.read_time, report.triangulation_time, report.write_time, option.files[i].c_str() );
+                    fflush( stdout );
+                } else {
+                    fprintf( stderr, "failed: %s\n", option.files[i].c_str() );
+                    ++failed;
+                }
+            }
+        } ) );
+    }
+    
+    for( auto& thread : pool ) {
+        thread.join();
+    }
+    
+    printf( "%lu of %lu files in %.4f s on %u threads\n", option.files.size() - failed, option.files.size(), Seconds( start ), threads );
+    
+    return ( failed == 0 ) ? 0 : 1;
+}